@@ -1,25 +1,21 @@
-QT       += core gui
+TEMPLATE = subdirs
 
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+# core - библиотека решателя без зависимости от Qt
+# gui  - графический интерфейс (ACOTCP)
+# cli  - консольный решатель aco-solve
+# bench - бенчмарки горячих участков решателя aco-bench
+# tune - подбор параметров aco-tune
+# tests - регрессионные проверки aco-tests
+SUBDIRS += \
+    core \
+    gui \
+    cli \
+    bench \
+    tune \
+    tests
 
-CONFIG += c++17
-
-# You can make your code fail to compile if it uses deprecated APIs.
-# In order to do so, uncomment the following line.
-#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
-
-SOURCES += \
-    antcolony.cpp \
-    graphscene.cpp \
-    main.cpp \
-    mainwindow.cpp
-
-HEADERS += \
-    antcolony.h \
-    graphscene.h \
-    mainwindow.h
-
-# Default rules for deployment.
-qnx: target.path = /tmp/$${TARGET}/bin
-else: unix:!android: target.path = /opt/$${TARGET}/bin
-!isEmpty(target.path): INSTALLS += target
+gui.depends = core
+cli.depends = core
+bench.depends = core
+tune.depends = core
+tests.depends = core
@@ -0,0 +1,20 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <cstddef>
+
+// Счётчики выделений памяти через глобальный operator new
+// (operator new заменяется в allocationcounter.cpp только для бенчмарка
+// и консольного решателя)
+namespace AllocationCounter {
+
+struct Totals {
+    std::size_t allocations;   // Количество вызовов operator new
+    std::size_t bytes;         // Суммарный запрошенный объём
+};
+
+Totals current();
+
+} // namespace AllocationCounter
+
+#endif // ALLOCATIONCOUNTER_H
@@ -0,0 +1,187 @@
+#include "antcolonybenchmark.h"
+#include "allocationcounter.h"
+#include <chrono>
+
+namespace {
+
+const char* samplingName(SamplingMode mode) {
+    switch (mode) {
+    case SamplingMode::Normalized:
+        return "normalized";
+    case SamplingMode::Tree:
+        return "tree";
+    default:
+        return "scaled";
+    }
+}
+
+} // namespace
+
+AntColonyBenchmark::AntColonyBenchmark(const BenchmarkCase& benchCase, double minSeconds, unsigned int seed)
+    : benchCase(benchCase), minSeconds(minSeconds),
+    colony(benchCase.vertices, benchCase.ants, benchCase.alpha, benchCase.beta, 0.5, 100.0,
+           std::numeric_limits<int>::max()),
+    allocationFree(true)
+{
+    colony.setSeed(seed);
+    colony.setThreadCount(benchCase.threads);
+    colony.setUseChoiceInfo(benchCase.choiceInfo);
+    colony.setStorageMode(benchCase.compact ? StorageMode::Compact : StorageMode::Dense);
+    colony.setSimdIsa(benchCase.isa);
+    colony.setSamplingMode(benchCase.sampling);
+    colony.setLazyEvaporation(benchCase.lazy);
+    colony.setCandidateListSize(benchCase.candidates);
+    colony.generateRandomGraph(10000, 10000);
+
+    // Несколько итераций, чтобы феромоны отличались от начальных
+    for (int i = 0; i < 3; ++i) {
+        colony.runIteration();
+    }
+}
+
+double AntColonyBenchmark::estimateMemory(const BenchmarkCase& benchCase) {
+    double n = benchCase.vertices;
+    double perAnt = n * (sizeof(int) * 2 + 1);
+
+    // Компактно: треугольники расстояний и феромонов по 4 байта, η^β и τ^α * η^β во float
+    double bytesPerEdge = benchCase.compact ? (benchCase.choiceInfo ? 12.0 : 8.0)
+                                            : (benchCase.choiceInfo ? 5.0 : 4.0) * sizeof(double);
+
+    // Деревья выбора - ещё одна матрица весов
+    if (benchCase.sampling == SamplingMode::Tree && benchCase.choiceInfo && benchCase.candidates == 0) {
+        bytesPerEdge += benchCase.compact ? sizeof(float) : sizeof(double);
+    }
+    return bytesPerEdge * n * n + benchCase.ants * perAnt;
+}
+
+template <typename Body>
+Measurement AntColonyBenchmark::measure(Body body) {
+    using Clock = std::chrono::steady_clock;
+
+    // Прогрев
+    body();
+
+    long long operations = 1;
+    while (true) {
+        AllocationCounter::Totals before = AllocationCounter::current();
+        Clock::time_point start = Clock::now();
+
+        for (long long i = 0; i < operations; ++i) {
+            body();
+        }
+
+        double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        AllocationCounter::Totals after = AllocationCounter::current();
+
+        if (elapsed >= minSeconds || operations >= (1LL << 40)) {
+            Measurement m;
+            m.secondsPerOp = elapsed / operations;
+            m.operations = operations;
+            m.allocationsPerOp = static_cast<double>(after.allocations - before.allocations) / operations;
+            m.bytesPerOp = static_cast<double>(after.bytes - before.bytes) / operations;
+            return m;
+        }
+
+        // Следующая попытка рассчитывается так, чтобы уложиться в minSeconds
+        double scale = elapsed > 0.0 ? 1.5 * minSeconds / elapsed : 100.0;
+        operations = static_cast<long long>(operations * std::min(std::max(scale, 2.0), 100.0));
+    }
+}
+
+void AntColonyBenchmark::prepareHalfTour(Ant& ant) {
+    // Полный маршрут, из которого посещённой оставлена первая половина
+    ant.reset(0);
+    colony.constructAntSolution(ant, colony.workerRngs[0]);
+
+    std::vector<int> route = ant.route;
+    ant.reset(route[0]);
+    for (int i = 1; i < benchCase.vertices / 2; ++i) {
+        ant.visit(route[i]);
+    }
+}
+
+void AntColonyBenchmark::report(std::FILE* out, const char* name, const Measurement& m, double stepsPerOp) {
+    if (m.allocationsPerOp > 0.0) {
+        allocationFree = false;
+    }
+
+    std::fprintf(out,
+                 "{\"benchmark\":\"%s\",\"vertices\":%d,\"ants\":%d,\"alpha\":%g,\"beta\":%g,"
+                 "\"candidates\":%d,\"choice_info\":%s,\"storage\":\"%s\",\"isa\":\"%s\",\"sampling\":\"%s\",\"evaporation\":\"%s\",\"threads\":%d,"
+                 "\"operations\":%lld,\"ns_per_op\":%.3f,\"ns_per_step\":%.3f,\"ops_per_s\":%.3f,"
+                 "\"allocations_per_op\":%.3f,\"bytes_allocated_per_op\":%.1f}\n",
+                 name, benchCase.vertices, benchCase.ants, benchCase.alpha, benchCase.beta,
+                 benchCase.candidates, benchCase.choiceInfo ? "true" : "false",
+                 benchCase.compact ? "compact" : "dense", simdIsaName(benchCase.isa),
+                 samplingName(benchCase.sampling), benchCase.lazy ? "lazy" : "eager", benchCase.threads,
+                 m.operations, m.secondsPerOp * 1e9, m.secondsPerOp * 1e9 / stepsPerOp,
+                 1.0 / m.secondsPerOp, m.allocationsPerOp, m.bytesPerOp);
+    std::fflush(out);
+}
+
+void AntColonyBenchmark::run(std::FILE* out) {
+    const int n = benchCase.vertices;
+    std::mt19937& rng = colony.workerRngs[0];
+
+    // Выбор следующей вершины на середине маршрута
+    Ant ant(n);
+    prepareHalfTour(ant);
+    volatile int sink = 0;
+    Measurement select = measure([&]() { sink = colony.selectNextVertex(ant, rng); });
+    report(out, "selectNextVertex", select, 1.0);
+
+    // Построение полного маршрута одним муравьём (шаг - одна вершина)
+    Measurement construct = measure([&]() {
+        ant.reset(0);
+        colony.constructAntSolution(ant, rng);
+    });
+    report(out, "constructAntSolution", construct, n);
+
+    // Пересчёт кэша τ^α * η^β по всей матрице (шаг - одно ребро)
+    if (benchCase.choiceInfo) {
+        Measurement choiceInfo = measure([&]() { colony.computeChoiceInfo(0, n); });
+        report(out, "computeChoiceInfo", choiceInfo, static_cast<double>(n) * n);
+    }
+
+    // Испарение по всей матрице (шаг - одно ребро)
+    Measurement evaporate = measure([&]() { colony.evaporatePheromones(0, n); });
+    report(out, "evaporatePheromones", evaporate, static_cast<double>(n) * n);
+
+    // Откладывание феромонов всеми муравьями (шаг - одно ребро маршрута)
+    Measurement deposit = measure([&]() { colony.depositPheromones(0, n); });
+    report(out, "depositPheromones", deposit, static_cast<double>(n) * benchCase.ants);
+
+    // Испарение, откладывание и обновление кэша за итерацию (шаг - одно ребро маршрута)
+    Measurement update = measure([&]() { colony.updatePheromones(); });
+    report(out, "updatePheromones", update, static_cast<double>(n) * benchCase.ants);
+
+    // Полная итерация (шаг - один выбор вершины одним муравьём)
+    Measurement iteration = measure([&]() { colony.runIteration(); });
+    report(out, "runIteration", iteration, static_cast<double>(n) * benchCase.ants);
+
+    // Локальный поиск по только что построенному маршруту (шаг - одна вершина)
+    colony.setLocalSearch(LocalSearchMode::IterationBest);
+    ant.reset(0);
+    colony.constructAntSolution(ant, rng);
+    std::vector<int> constructed = ant.route;
+    double constructedCost = ant.totalCost;
+
+    Measurement localSearch = measure([&]() {
+        std::copy(constructed.begin(), constructed.end(), ant.route.begin());
+        ant.totalCost = constructedCost;
+        colony.improveAntSolution(ant, colony.localSearchers[0]);
+    });
+    report(out, "localSearch", localSearch, n);
+    colony.setLocalSearch(LocalSearchMode::None);
+
+    // Перемещение случайной вершины с восстановлением лучшего маршрута (шаг - одна вершина)
+    std::mt19937 moveRng(benchCase.vertices);
+    std::uniform_int_distribution<int> moveVertex(0, n - 1);
+    std::uniform_real_distribution<double> moveCoord(0.0, 10000.0);
+    Measurement move = measure([&]() {
+        colony.moveVertex(moveVertex(moveRng), Point(moveCoord(moveRng), moveCoord(moveRng)));
+    });
+    report(out, "moveVertex", move, n);
+
+    (void)sink;
+}
@@ -0,0 +1,59 @@
+#ifndef ANTCOLONYBENCHMARK_H
+#define ANTCOLONYBENCHMARK_H
+
+#include <cstdio>
+#include <cstddef>
+#include <string>
+#include "antcolony.h"
+
+// Параметры одного прогона бенчмарка
+struct BenchmarkCase {
+    int vertices;
+    int ants;
+    double alpha;
+    double beta;
+    int candidates;       // Размер списка кандидатов (0 - полный перебор)
+    bool choiceInfo;      // Использовать кэш τ^α * η^β
+    bool compact;         // Компактное хранение матриц (StorageMode::Compact)
+    SimdIsa isa;          // Набор инструкций ядер весов
+    SamplingMode sampling; // Рулетка при полном переборе
+    bool lazy;            // Ленивое испарение
+    int threads;
+};
+
+// Результат замера одной операции
+struct Measurement {
+    double secondsPerOp;        // Среднее время одной операции
+    long long operations;       // Количество выполненных операций
+    double allocationsPerOp;    // Вызовов operator new на операцию
+    double bytesPerOp;          // Выделено байт на операцию
+};
+
+// Замер горячих участков AntColony по отдельности.
+// Результаты выводятся построчно в формате JSON (JSON Lines).
+class AntColonyBenchmark {
+public:
+    AntColonyBenchmark(const BenchmarkCase& benchCase, double minSeconds, unsigned int seed);
+
+    // Оценка памяти, нужной колонии, в байтах
+    static double estimateMemory(const BenchmarkCase& benchCase);
+
+    void run(std::FILE* out);
+
+    // Ни один замер не выделял память (после прогрева)
+    bool isAllocationFree() const { return allocationFree; }
+
+private:
+    template <typename Body>
+    Measurement measure(Body body);
+
+    void report(std::FILE* out, const char* name, const Measurement& m, double stepsPerOp);
+    void prepareHalfTour(Ant& ant);
+
+    BenchmarkCase benchCase;
+    double minSeconds;
+    AntColony colony;
+    bool allocationFree;
+};
+
+#endif // ANTCOLONYBENCHMARK_H
@@ -0,0 +1,16 @@
+TEMPLATE = app
+TARGET = aco-bench
+
+CONFIG += console c++17
+CONFIG -= qt app_bundle
+
+include(../core/core.pri)
+
+SOURCES += \
+    allocationcounter.cpp \
+    antcolonybenchmark.cpp \
+    main.cpp
+
+HEADERS += \
+    allocationcounter.h \
+    antcolonybenchmark.h
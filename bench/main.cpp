@@ -0,0 +1,199 @@
+#include "antcolonybenchmark.h"
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Параметры сетки бенчмарков
+struct Options {
+    std::vector<int> vertices = { 50, 200, 1000, 5000 };
+    std::vector<int> ants = { 20 };
+    std::vector<double> alphas = { 1.0 };
+    std::vector<double> betas = { 2.0 };
+    std::vector<int> candidates = { 0, 15 };
+    std::vector<int> choiceInfo = { 1, 0 };
+    std::vector<std::string> storage = { "dense" };
+    std::vector<SimdIsa> isas = { detectSimdIsa() };
+    std::vector<std::string> sampling = { "scaled" };
+    std::vector<std::string> evaporation = { "eager" };
+    std::vector<int> threads = { 1 };
+    double minSeconds = 0.2;
+    double maxMemoryMb = 4096.0;
+    unsigned int seed = 12345;
+    bool checkAllocations = false;
+};
+
+// Набор инструкций по имени; "all" - все поддерживаемые процессором
+bool parseIsas(const char* text, std::vector<SimdIsa>& isas) {
+    const SimdIsa all[] = { SimdIsa::Scalar, SimdIsa::Sse41, SimdIsa::Avx2, SimdIsa::Avx512 };
+
+    isas.clear();
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        bool known = false;
+        for (SimdIsa isa : all) {
+            if (item == "all" ? isSimdIsaSupported(isa) : item == simdIsaName(isa)) {
+                isas.push_back(isa);
+                known = true;
+            }
+        }
+        if (!known && item != "all") {
+            std::fprintf(stderr, "Unknown instruction set %s\n", item.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+std::vector<T> parseList(const char* text) {
+    std::vector<T> values;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        std::stringstream value(item);
+        T parsed;
+        if (value >> parsed) {
+            values.push_back(parsed);
+        }
+    }
+    return values;
+}
+
+void printUsage(const char* program) {
+    std::fprintf(stderr,
+        "Usage: %s [options]\n"
+        "\n"
+        "Times selectNextVertex, constructAntSolution, evaporatePheromones,\n"
+        "depositPheromones, updatePheromones, runIteration, localSearch and\n"
+        "moveVertex for every combination of the lists below and prints one\n"
+        "JSON object per line to stdout.\n"
+        "\n"
+        "Options (comma-separated lists):\n"
+        "  --vertices LIST      graph sizes (default 50,200,1000,5000)\n"
+        "  --ants LIST          ant counts (default 20)\n"
+        "  --alpha LIST         alpha values (default 1)\n"
+        "  --beta LIST          beta values (default 2)\n"
+        "  --candidates LIST    candidate list sizes, 0 = full scan (default 0,15)\n"
+        "  --choice-info LIST   1 = cached choice info, 0 = pow per candidate (default 1,0)\n"
+        "  --storage LIST       dense or compact matrices (default dense)\n"
+        "  --isa LIST           weight kernels: scalar, sse4, avx2, avx512 or all\n"
+        "                       (default: best supported)\n"
+        "  --sampling LIST      full-scan roulette: normalized, scaled or tree\n"
+        "                       (default scaled)\n"
+        "  --evaporation LIST   eager or lazy (default eager)\n"
+        "  --threads LIST       worker threads (default 1)\n"
+        "  --min-time S         minimum measured time per benchmark (default 0.2)\n"
+        "  --max-memory MB      skip cases needing more memory (default 4096)\n"
+        "  --seed N             random seed (default 12345)\n"
+        "  --check-allocations  exit with status 1 if a measured operation allocates\n"
+        "                       memory after warm-up\n",
+        program);
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--check-allocations") == 0) {
+            options.checkAllocations = true;
+            continue;
+        }
+        if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0 || i + 1 >= argc) {
+            return false;
+        }
+        const char* value = argv[++i];
+
+        if (std::strcmp(arg, "--vertices") == 0) options.vertices = parseList<int>(value);
+        else if (std::strcmp(arg, "--ants") == 0) options.ants = parseList<int>(value);
+        else if (std::strcmp(arg, "--alpha") == 0) options.alphas = parseList<double>(value);
+        else if (std::strcmp(arg, "--beta") == 0) options.betas = parseList<double>(value);
+        else if (std::strcmp(arg, "--candidates") == 0) options.candidates = parseList<int>(value);
+        else if (std::strcmp(arg, "--choice-info") == 0) options.choiceInfo = parseList<int>(value);
+        else if (std::strcmp(arg, "--storage") == 0) options.storage = parseList<std::string>(value);
+        else if (std::strcmp(arg, "--sampling") == 0) options.sampling = parseList<std::string>(value);
+        else if (std::strcmp(arg, "--evaporation") == 0) options.evaporation = parseList<std::string>(value);
+        else if (std::strcmp(arg, "--isa") == 0) {
+            if (!parseIsas(value, options.isas)) {
+                return false;
+            }
+        }
+        else if (std::strcmp(arg, "--threads") == 0) options.threads = parseList<int>(value);
+        else if (std::strcmp(arg, "--min-time") == 0) options.minSeconds = std::atof(value);
+        else if (std::strcmp(arg, "--max-memory") == 0) options.maxMemoryMb = std::atof(value);
+        else if (std::strcmp(arg, "--seed") == 0) options.seed = static_cast<unsigned int>(std::atoll(value));
+        else {
+            std::fprintf(stderr, "Unknown option %s\n", arg);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    bool allocating = false;
+
+    for (int vertices : options.vertices)
+    for (int ants : options.ants)
+    for (double alpha : options.alphas)
+    for (double beta : options.betas)
+    for (int candidates : options.candidates)
+    for (int choiceInfo : options.choiceInfo)
+    for (const std::string& storage : options.storage)
+    for (SimdIsa isa : options.isas)
+    for (const std::string& sampling : options.sampling)
+    for (const std::string& evaporation : options.evaporation)
+    for (int threads : options.threads) {
+        if (storage != "dense" && storage != "compact") {
+            std::fprintf(stderr, "Unknown storage mode %s\n", storage.c_str());
+            return 2;
+        }
+        SamplingMode samplingMode;
+        if (sampling == "normalized") samplingMode = SamplingMode::Normalized;
+        else if (sampling == "scaled") samplingMode = SamplingMode::Scaled;
+        else if (sampling == "tree") samplingMode = SamplingMode::Tree;
+        else {
+            std::fprintf(stderr, "Unknown sampling mode %s\n", sampling.c_str());
+            return 2;
+        }
+        if (evaporation != "eager" && evaporation != "lazy") {
+            std::fprintf(stderr, "Unknown evaporation mode %s\n", evaporation.c_str());
+            return 2;
+        }
+        BenchmarkCase benchCase = { vertices, ants, alpha, beta, candidates, choiceInfo != 0,
+                                    storage == "compact", isa, samplingMode, evaporation == "lazy", threads };
+
+        double memoryMb = AntColonyBenchmark::estimateMemory(benchCase) / (1024.0 * 1024.0);
+        if (vertices < 2 || ants < 1 || memoryMb > options.maxMemoryMb) {
+            std::printf("{\"benchmark\":\"skipped\",\"vertices\":%d,\"ants\":%d,\"estimated_memory_mb\":%.1f}\n",
+                        vertices, ants, memoryMb);
+            continue;
+        }
+        if (!isSimdIsaSupported(isa)) {
+            std::printf("{\"benchmark\":\"skipped\",\"isa\":\"%s\",\"reason\":\"unsupported\"}\n", simdIsaName(isa));
+            continue;
+        }
+
+        AntColonyBenchmark benchmark(benchCase, options.minSeconds, options.seed);
+        benchmark.run(stdout);
+
+        if (options.checkAllocations && !benchmark.isAllocationFree()) {
+            std::fprintf(stderr, "Allocations in steady state: %d vertices, %d candidates, choice info %d\n",
+                         vertices, candidates, choiceInfo);
+            allocating = true;
+        }
+    }
+
+    return allocating ? 1 : 0;
+}
@@ -0,0 +1,22 @@
+TEMPLATE = app
+TARGET = aco-solve
+
+CONFIG += console c++17
+CONFIG -= qt app_bundle
+
+include(../core/core.pri)
+
+# Счётчик выделений памяти бенчмарка - для поля allocations журнала статистики
+INCLUDEPATH += ../bench
+
+SOURCES += \
+    ../bench/allocationcounter.cpp \
+    main.cpp
+
+HEADERS += \
+    ../bench/allocationcounter.h
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
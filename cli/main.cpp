@@ -0,0 +1,538 @@
+#include "allocationcounter.h"
+#include "antcolony.h"
+#include "checkpoint.h"
+#include "configfile.h"
+#include "islandmodel.h"
+#include "statisticslog.h"
+#include "tracelog.h"
+#include "tsplib.h"
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <climits>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace {
+
+// Параметры запуска консольного решателя
+struct Options {
+    std::string instancePath;    // Файл с вершинами (пусто - случайный граф)
+    int randomVertices = 50;     // Количество вершин случайного графа
+    int ants = 20;
+    int iterations = 100;
+    double alpha = 1.0;
+    double beta = 2.0;
+    double rho = 0.5;
+    double Q = 100.0;
+    int candidates = 15;
+    LocalSearchMode localSearch = LocalSearchMode::None;
+    AcoVariant variant = AcoVariant::AntSystem;
+    VariantParameters variantParameters;
+    StorageMode storage = StorageMode::Dense;
+    SimdIsa isa = detectSimdIsa();
+    SamplingMode sampling = SamplingMode::Scaled;
+    bool lazyEvaporation = false;
+    int islands = 1;             // Количество колоний островной модели
+    MigrationScheme migration = MigrationScheme::Ring;
+    int migrationInterval = 20;
+    double islandSpread = 0.0;   // Разброс beta и rho между островами (доля от значения)
+    int threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    long long seed = -1;         // -1 - случайное зерно
+    std::string checkpointPath;  // Файл контрольных точек (пусто - не сохранять)
+    int checkpointIterations = 100;
+    double checkpointSeconds = 0.0;
+    std::string resumePath;      // Контрольная точка для продолжения
+    std::string tracePath;       // Файл трассы (пусто - не записывать)
+    int traceKeyframes = 100;
+    bool tracePheromones = true;
+    std::string statisticsPath;  // Журнал статистики итераций (пусто - не собирать)
+    TerminationCriteria termination;
+    double targetGap = -1.0;     // Допустимый разрыв до optimum (< 0 - не задан)
+    double optimum = 0.0;        // Известная оптимальная стоимость для targetGap
+    RestartParameters restart;
+};
+
+// Прерывание (Ctrl+C): итерации останавливаются, и решатель выводит лучший
+// найденный маршрут (и сохраняет контрольную точку, если она задана)
+volatile std::sig_atomic_t interrupted = 0;
+
+void onInterrupt(int) {
+    interrupted = 1;
+}
+
+void printUsage(const char* program) {
+    std::printf(
+        "Usage: %s [options] [instance]\n"
+        "\n"
+        "Instance file: a TSPLIB .tsp/.atsp file, or one vertex per line as\n"
+        "\"x y [visitCost]\" where '#' starts a comment.\n"
+        "Without an instance a random graph is generated.\n"
+        "\n"
+        "Options:\n"
+        "  --random N        vertices in the random graph (default 50)\n"
+        "  --ants N          number of ants (default 20)\n"
+        "  --iterations N    number of iterations, 0 = no limit (needs another\n"
+        "                    stopping rule below) (default 100)\n"
+        "  --alpha X         pheromone influence (default 1.0)\n"
+        "  --beta X          heuristic influence (default 2.0)\n"
+        "  --rho X           evaporation rate (default 0.5)\n"
+        "  --q X             pheromone deposit constant (default 100)\n"
+        "  --candidates K    candidate list size, 0 = full scan (default 15)\n"
+        "  --local-search M  2-opt/Or-opt after construction: none, best\n"
+        "                    (iteration-best ant) or all (default none)\n"
+        "  --variant V       as, elitist, rank, mmas or acs (default as)\n"
+        "  --elitist-weight X  elitist: weight of the best tour (default 5)\n"
+        "  --ranks N         rank: number of ranks (default 6)\n"
+        "  --mmas-deposit S  mmas: iteration or global best deposits (default iteration)\n"
+        "  --pbest X         mmas: probability that defines the lower bound (default 0.05)\n"
+        "  --mmas-restart N  mmas: reinitialise after N stagnant iterations, 0 = never (default 100)\n"
+        "  --q0 X            acs: probability of taking the best edge (default 0.9)\n"
+        "  --xi X            acs: local update rate (default 0.1)\n"
+        "  --storage S       dense or compact (symmetric instances: upper triangle,\n"
+        "                    float pheromone, int32/float distances) (default dense)\n"
+        "  --sampling S      full-scan roulette: normalized, scaled or tree\n"
+        "                    (shared Fenwick trees, O(log N) per draw) (default scaled)\n"
+        "  --evaporation E   eager (every edge each iteration) or lazy (global\n"
+        "                    decay factor, only deposited edges) (default eager)\n"
+        "  --isa I           weight kernels: scalar, sse4, avx2 or avx512\n"
+        "                    (default: best supported)\n"
+        "  --islands N       independent colonies that exchange tours (default 1)\n"
+        "  --migration M     ring, full (global best to every island) or merge\n"
+        "                    (blend pheromone towards the island mean) (default ring)\n"
+        "  --migration-interval N  iterations between exchanges, 0 = never (default 20)\n"
+        "  --island-spread X vary beta and rho by up to +-X (fraction) across islands\n"
+        "                    (default 0)\n"
+        "  --threads N       worker threads, split between islands\n"
+        "                    (default: hardware concurrency)\n"
+        "  --seed N          random seed (default: random)\n"
+        "  --checkpoint F    save the colony state to F periodically, on Ctrl+C\n"
+        "                    and at the end (single colony only)\n"
+        "  --checkpoint-every N  iterations between checkpoints, 0 = off (default 100)\n"
+        "  --checkpoint-seconds X  seconds between checkpoints, 0 = off (default 0)\n"
+        "  --resume F        continue from checkpoint F (graph and parameters come\n"
+        "                    from the file; the instance argument is ignored)\n"
+        "  --trace F         record the run to F for replay in the GUI\n"
+        "  --trace-keyframes N  iterations between trace keyframes (default 100)\n"
+        "  --trace-pheromone B  yes or no: quantised pheromone in keyframes (default yes)\n"
+        "  --time-limit MS   stop when the next iteration would exceed MS milliseconds\n"
+        "  --target-cost C   stop when a tour of cost <= C is found\n"
+        "  --target-gap X    stop within X (fraction) of --optimum C\n"
+        "  --optimum C       known optimal cost for --target-gap\n"
+        "  --stall-iterations N  stop after N iterations without improvement\n"
+        "  --stall-seconds X stop after X seconds without improvement\n"
+        "  --restart-branching X  reinitialise pheromone when the mean lambda-branching\n"
+        "                    factor drops below X (MMAS converges near 2) (default off)\n"
+        "  --restart-diversity X  reinitialise pheromone when the fraction of ant edges\n"
+        "                    outside the iteration-best tour drops below X (default off)\n"
+        "  --restart-interval N  iterations between stagnation checks (default 10)\n"
+        "  --stats F         write per-iteration phase times and convergence metrics\n"
+        "                    to F: CSV if F ends in .csv, otherwise JSON Lines\n"
+        "  --config F        read options from F, one \"option value\" per line\n"
+        "                    without the leading --; later options override it\n"
+        "                    (aco-tune writes such files)\n"
+        "  --help            show this help\n",
+        program);
+}
+
+// Опция arg со значением value (из командной строки или файла настроек)
+bool applyOption(const char* arg, const char* value, Options& options) {
+    if (std::strcmp(arg, "--random") == 0) options.randomVertices = std::atoi(value);
+    else if (std::strcmp(arg, "--ants") == 0) options.ants = std::atoi(value);
+    else if (std::strcmp(arg, "--iterations") == 0) options.iterations = std::atoi(value);
+    else if (std::strcmp(arg, "--alpha") == 0) options.alpha = std::atof(value);
+    else if (std::strcmp(arg, "--beta") == 0) options.beta = std::atof(value);
+    else if (std::strcmp(arg, "--rho") == 0) options.rho = std::atof(value);
+    else if (std::strcmp(arg, "--q") == 0) options.Q = std::atof(value);
+    else if (std::strcmp(arg, "--candidates") == 0) options.candidates = std::atoi(value);
+    else if (std::strcmp(arg, "--local-search") == 0) {
+        if (std::strcmp(value, "none") == 0) options.localSearch = LocalSearchMode::None;
+        else if (std::strcmp(value, "best") == 0) options.localSearch = LocalSearchMode::IterationBest;
+        else if (std::strcmp(value, "all") == 0) options.localSearch = LocalSearchMode::AllAnts;
+        else {
+            std::fprintf(stderr, "Unknown local search mode %s\n", value);
+            return false;
+        }
+    }
+    else if (std::strcmp(arg, "--variant") == 0) {
+        if (std::strcmp(value, "as") == 0) options.variant = AcoVariant::AntSystem;
+        else if (std::strcmp(value, "elitist") == 0) options.variant = AcoVariant::ElitistAntSystem;
+        else if (std::strcmp(value, "rank") == 0) options.variant = AcoVariant::RankBasedAntSystem;
+        else if (std::strcmp(value, "mmas") == 0) options.variant = AcoVariant::MaxMinAntSystem;
+        else if (std::strcmp(value, "acs") == 0) options.variant = AcoVariant::AntColonySystem;
+        else {
+            std::fprintf(stderr, "Unknown variant %s\n", value);
+            return false;
+        }
+    }
+    else if (std::strcmp(arg, "--elitist-weight") == 0) options.variantParameters.elitistWeight = std::atof(value);
+    else if (std::strcmp(arg, "--ranks") == 0) options.variantParameters.rankedAnts = std::atoi(value);
+    else if (std::strcmp(arg, "--mmas-deposit") == 0) {
+        if (std::strcmp(value, "iteration") == 0) options.variantParameters.mmasGlobalBest = false;
+        else if (std::strcmp(value, "global") == 0) options.variantParameters.mmasGlobalBest = true;
+        else {
+            std::fprintf(stderr, "Unknown MMAS deposit %s\n", value);
+            return false;
+        }
+    }
+    else if (std::strcmp(arg, "--pbest") == 0) options.variantParameters.mmasPBest = std::atof(value);
+    else if (std::strcmp(arg, "--mmas-restart") == 0) options.variantParameters.mmasRestartIterations = std::atoi(value);
+    else if (std::strcmp(arg, "--q0") == 0) options.variantParameters.acsQ0 = std::atof(value);
+    else if (std::strcmp(arg, "--xi") == 0) options.variantParameters.acsXi = std::atof(value);
+    else if (std::strcmp(arg, "--storage") == 0) {
+        if (std::strcmp(value, "dense") == 0) options.storage = StorageMode::Dense;
+        else if (std::strcmp(value, "compact") == 0) options.storage = StorageMode::Compact;
+        else {
+            std::fprintf(stderr, "Unknown storage mode %s\n", value);
+            return false;
+        }
+    }
+    else if (std::strcmp(arg, "--sampling") == 0) {
+        if (std::strcmp(value, "normalized") == 0) options.sampling = SamplingMode::Normalized;
+        else if (std::strcmp(value, "scaled") == 0) options.sampling = SamplingMode::Scaled;
+        else if (std::strcmp(value, "tree") == 0) options.sampling = SamplingMode::Tree;
+        else {
+            std::fprintf(stderr, "Unknown sampling mode %s\n", value);
+            return false;
+        }
+    }
+    else if (std::strcmp(arg, "--evaporation") == 0) {
+        if (std::strcmp(value, "eager") == 0) options.lazyEvaporation = false;
+        else if (std::strcmp(value, "lazy") == 0) options.lazyEvaporation = true;
+        else {
+            std::fprintf(stderr, "Unknown evaporation mode %s\n", value);
+            return false;
+        }
+    }
+    else if (std::strcmp(arg, "--isa") == 0) {
+        const SimdIsa all[] = { SimdIsa::Scalar, SimdIsa::Sse41, SimdIsa::Avx2, SimdIsa::Avx512 };
+        bool known = false;
+        for (SimdIsa isa : all) {
+            if (std::strcmp(value, simdIsaName(isa)) == 0) {
+                options.isa = isa;
+                known = true;
+            }
+        }
+        if (!known || !isSimdIsaSupported(options.isa)) {
+            std::fprintf(stderr, "Unsupported instruction set %s\n", value);
+            return false;
+        }
+    }
+    else if (std::strcmp(arg, "--islands") == 0) options.islands = std::atoi(value);
+    else if (std::strcmp(arg, "--migration") == 0) {
+        if (std::strcmp(value, "ring") == 0) options.migration = MigrationScheme::Ring;
+        else if (std::strcmp(value, "full") == 0) options.migration = MigrationScheme::FullyConnected;
+        else if (std::strcmp(value, "merge") == 0) options.migration = MigrationScheme::MergePheromone;
+        else {
+            std::fprintf(stderr, "Unknown migration scheme %s\n", value);
+            return false;
+        }
+    }
+    else if (std::strcmp(arg, "--migration-interval") == 0) options.migrationInterval = std::atoi(value);
+    else if (std::strcmp(arg, "--island-spread") == 0) options.islandSpread = std::atof(value);
+    else if (std::strcmp(arg, "--threads") == 0) options.threads = std::atoi(value);
+    else if (std::strcmp(arg, "--seed") == 0) options.seed = std::atoll(value);
+    else if (std::strcmp(arg, "--checkpoint") == 0) options.checkpointPath = value;
+    else if (std::strcmp(arg, "--checkpoint-every") == 0) options.checkpointIterations = std::atoi(value);
+    else if (std::strcmp(arg, "--checkpoint-seconds") == 0) options.checkpointSeconds = std::atof(value);
+    else if (std::strcmp(arg, "--resume") == 0) options.resumePath = value;
+    else if (std::strcmp(arg, "--trace") == 0) options.tracePath = value;
+    else if (std::strcmp(arg, "--trace-keyframes") == 0) options.traceKeyframes = std::atoi(value);
+    else if (std::strcmp(arg, "--trace-pheromone") == 0) {
+        if (std::strcmp(value, "yes") == 0) options.tracePheromones = true;
+        else if (std::strcmp(value, "no") == 0) options.tracePheromones = false;
+        else {
+            std::fprintf(stderr, "Expected yes or no for --trace-pheromone\n");
+            return false;
+        }
+    }
+    else if (std::strcmp(arg, "--stats") == 0) options.statisticsPath = value;
+    else if (std::strcmp(arg, "--time-limit") == 0) options.termination.timeLimitMs = std::atoi(value);
+    else if (std::strcmp(arg, "--target-cost") == 0) options.termination.targetCost = std::atof(value);
+    else if (std::strcmp(arg, "--target-gap") == 0) options.targetGap = std::atof(value);
+    else if (std::strcmp(arg, "--optimum") == 0) options.optimum = std::atof(value);
+    else if (std::strcmp(arg, "--stall-iterations") == 0) options.termination.stallIterations = std::atoi(value);
+    else if (std::strcmp(arg, "--stall-seconds") == 0) {
+        options.termination.stallMs = static_cast<int>(std::atof(value) * 1000.0);
+    }
+    else if (std::strcmp(arg, "--restart-branching") == 0) options.restart.minBranching = std::atof(value);
+    else if (std::strcmp(arg, "--restart-diversity") == 0) options.restart.minDiversity = std::atof(value);
+    else if (std::strcmp(arg, "--restart-interval") == 0) options.restart.checkInterval = std::atoi(value);
+    else {
+        std::fprintf(stderr, "Unknown option %s\n", arg);
+        return false;
+    }
+    return true;
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0) {
+            printUsage(argv[0]);
+            std::exit(0);
+        } else if (arg[0] == '-' && arg[1] == '-') {
+            if (!hasValue) {
+                std::fprintf(stderr, "Missing value for %s\n", arg);
+                return false;
+            }
+            const char* value = argv[++i];
+
+            if (std::strcmp(arg, "--config") == 0) {
+                // Настройки из файла; опции после --config их переопределяют
+                std::vector<ConfigEntry> entries;
+                std::string error;
+                if (!readConfigFile(value, entries, error)) {
+                    std::fprintf(stderr, "%s\n", error.c_str());
+                    return false;
+                }
+                for (const ConfigEntry& entry : entries) {
+                    if (!applyOption(("--" + entry.key).c_str(), entry.value.c_str(), options)) {
+                        return false;
+                    }
+                }
+            } else if (!applyOption(arg, value, options)) {
+                return false;
+            }
+        } else {
+            options.instancePath = arg;
+        }
+    }
+
+    if (options.ants <= 0 || options.iterations < 0 || options.randomVertices < 2 || options.islands <= 0) {
+        std::fprintf(stderr, "ants, iterations, vertices and islands must be positive\n");
+        return false;
+    }
+    if (options.targetGap >= 0.0) {
+        if (options.optimum <= 0.0) {
+            std::fprintf(stderr, "--target-gap needs --optimum\n");
+            return false;
+        }
+        options.termination.targetCost = options.optimum * (1.0 + options.targetGap);
+    }
+    if (options.iterations == 0) {
+        const TerminationCriteria& t = options.termination;
+        if (t.timeLimitMs <= 0 && t.targetCost <= 0.0 && t.stallIterations <= 0 && t.stallMs <= 0) {
+            std::fprintf(stderr, "--iterations 0 needs a time limit, target or stall rule\n");
+            return false;
+        }
+        options.iterations = INT_MAX;
+    }
+    if (options.islands > 1 && (!options.checkpointPath.empty() || !options.resumePath.empty())) {
+        std::fprintf(stderr, "checkpoints need a single colony (--islands 1)\n");
+        return false;
+    }
+    return true;
+}
+
+// Чтение вершин из текстового файла "x y [visitCost]"
+bool readVertices(const std::string& path, std::vector<Vertex>& vertices) {
+    std::ifstream in(path);
+    if (!in) {
+        std::fprintf(stderr, "Cannot open %s\n", path.c_str());
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(in, line)) {
+        std::string::size_type comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+
+        std::istringstream fields(line);
+        double x, y;
+        if (!(fields >> x >> y)) {
+            continue;
+        }
+
+        double visitCost = 0.0;
+        fields >> visitCost;
+        vertices.emplace_back(static_cast<int>(vertices.size()), Point(x, y), visitCost);
+    }
+
+    if (vertices.size() < 2) {
+        std::fprintf(stderr, "%s: at least two vertices are required\n", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Файлы с расширением .tsp/.atsp читаются как TSPLIB
+bool isTsplibPath(const std::string& path) {
+    auto endsWith = [&path](const char* suffix) {
+        std::size_t length = std::strlen(suffix);
+        return path.size() >= length && path.compare(path.size() - length, length, suffix) == 0;
+    };
+    return endsWith(".tsp") || endsWith(".atsp") || endsWith(".TSP") || endsWith(".ATSP");
+}
+
+// Колония острова island: при разбросе beta и rho равномерно распределены
+// в [1 - spread, 1 + spread] от заданных, зёрна островов различаются
+std::unique_ptr<AntColony> createIsland(const Options& options, int island) {
+    double offset = options.islands > 1 ? 2.0 * island / (options.islands - 1) - 1.0 : 0.0;
+    double factor = 1.0 + options.islandSpread * offset;
+    double rho = std::min(std::max(options.rho * factor, 0.01), 0.99);
+
+    std::unique_ptr<AntColony> colony(new AntColony(options.randomVertices, options.ants, options.alpha,
+                                                    options.beta * factor, rho, options.Q, options.iterations));
+    if (options.seed >= 0) {
+        colony->setSeed(static_cast<unsigned int>(options.seed + island));
+    }
+    colony->setStorageMode(options.storage);
+    colony->setSimdIsa(options.isa);
+    colony->setSamplingMode(options.sampling);
+    colony->setLazyEvaporation(options.lazyEvaporation);
+    colony->setCandidateListSize(options.candidates);
+    colony->setLocalSearch(options.localSearch);
+    colony->setVariant(options.variant, options.variantParameters);
+    colony->setRestart(options.restart);
+    colony->setThreadCount(std::max(1, options.threads / options.islands));
+    if (!options.statisticsPath.empty()) {
+        // Счётчик общий для процесса: с островами в него входят выделения всех островов
+        colony->setStatisticsEnabled(true);
+        colony->setAllocationCounter([]() { return AllocationCounter::current().allocations; });
+    }
+    return colony;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    // Одна колония - это модель из одного острова (без обменов)
+    IslandModel model;
+    for (int island = 0; island < options.islands; ++island) {
+        model.addIsland(createIsland(options, island));
+    }
+    model.setMigration(options.migration, options.migrationInterval);
+    model.setTermination(options.termination);
+
+    auto loadStart = std::chrono::steady_clock::now();
+
+    if (!options.resumePath.empty()) {
+        std::string error;
+        if (!loadCheckpoint(options.resumePath, model.getIsland(0), error)) {
+            std::fprintf(stderr, "%s: %s\n", options.resumePath.c_str(), error.c_str());
+            return 1;
+        }
+    } else if (options.instancePath.empty()) {
+        model.generateRandomGraph(1000, 1000);
+    } else if (isTsplibPath(options.instancePath)) {
+        Instance instance;
+        std::string error;
+        if (!loadTsplib(options.instancePath, instance, error)) {
+            std::fprintf(stderr, "%s: %s\n", options.instancePath.c_str(), error.c_str());
+            return 1;
+        }
+        model.setInstance(instance);
+    } else {
+        std::vector<Vertex> vertices;
+        if (!readVertices(options.instancePath, vertices)) {
+            return 1;
+        }
+        model.setGraph(vertices);
+    }
+
+    // Запись контрольных точек идёт в отдельном потоке и итерации не задерживает
+    std::unique_ptr<CheckpointWriter> checkpoints;
+    if (!options.checkpointPath.empty()) {
+        checkpoints.reset(new CheckpointWriter(options.checkpointPath));
+        checkpoints->setInterval(options.checkpointIterations, static_cast<int>(options.checkpointSeconds * 1000.0));
+    }
+    std::signal(SIGINT, onInterrupt);
+
+    // Трасса записывает остров с лучшим маршрутом
+    TraceRecorder trace;
+    if (!options.tracePath.empty()) {
+        std::string error;
+        if (!trace.open(options.tracePath, model.getIsland(0), options.traceKeyframes, options.tracePheromones, error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+    }
+
+    // Статистика пишется для каждого острова после итерации модели
+    StatisticsLog statistics;
+    if (!options.statisticsPath.empty()) {
+        std::string error;
+        if (!statistics.open(options.statisticsPath, error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+    }
+
+    int startIteration = model.getCurrentIteration();
+    auto solveStart = std::chrono::steady_clock::now();
+    while (!model.isFinished() && !interrupted) {
+        model.runIteration();
+        if (trace.isOpen()) {
+            trace.record(model.getIsland(model.getBestIsland()));
+        }
+        if (statistics.isOpen()) {
+            for (int island = 0; island < model.getIslandCount(); ++island) {
+                statistics.write(model.getIsland(island).getLastStatistics(), island);
+            }
+        }
+        if (checkpoints) {
+            checkpoints->onIteration(model.getIsland(0));
+        }
+    }
+    auto solveEnd = std::chrono::steady_clock::now();
+    trace.close();
+    statistics.close();
+
+    if (checkpoints) {
+        checkpoints->save(model.getIsland(0));
+        checkpoints->flush();
+        if (!checkpoints->getLastError().empty()) {
+            std::fprintf(stderr, "checkpoint: %s\n", checkpoints->getLastError().c_str());
+        }
+    }
+
+    const AntColony& colony = model.getIsland(model.getBestIsland());
+
+    double loadSeconds = std::chrono::duration<double>(solveStart - loadStart).count();
+    double solveSeconds = std::chrono::duration<double>(solveEnd - solveStart).count();
+
+    std::printf("vertices: %d\n", colony.getNumVertices());
+    std::printf("cost: %.6f\n", colony.getBestCost());
+    std::printf("tour:");
+    for (int vertex : colony.getBestRoute()) {
+        std::printf(" %d", vertex);
+    }
+    std::printf("\n");
+    std::printf("matrices: %s, %.1f MB, %s kernels\n", colony.isCompactStorage() ? "compact" : "dense",
+                colony.getMatrixBytes() / (1024.0 * 1024.0), simdIsaName(colony.getSimdIsa()));
+    if (model.getIslandCount() > 1) {
+        std::printf("islands: %d, best from island %d, %d migrations\n", model.getIslandCount(),
+                    model.getBestIsland(), model.getMigrationCount());
+    }
+    int restarts = 0;
+    for (int island = 0; island < model.getIslandCount(); ++island) {
+        restarts += model.getIsland(island).getRestartCount();
+    }
+    std::printf("stopped by: %s, %d restarts\n",
+                interrupted ? "interrupt" : terminationReasonName(model.getTerminationReason()), restarts);
+    if (checkpoints) {
+        std::printf("checkpoints: %d written to %s%s\n", checkpoints->getSavedCount(),
+                    options.checkpointPath.c_str(), interrupted ? " (interrupted)" : "");
+    }
+    int solvedIterations = colony.getCurrentIteration() - startIteration;
+    std::printf("load time: %.3f s\n", loadSeconds);
+    std::printf("solve time: %.3f s (%d iterations, %.3f ms/iteration)\n",
+                solveSeconds, solvedIterations, 1000.0 * solveSeconds / std::max(1, solvedIterations));
+
+    return 0;
+}
@@ -0,0 +1,2205 @@
+#include "antcolony.h"
+#include "checkpoint.h"
+#include "choicekernel.h"
+#include "kdtree.h"
+#include <cstring>
+#include <sstream>
+#include <type_traits>
+
+namespace {
+
+// Размер списков соседей для локального поиска, если списки кандидатов отключены
+const int LocalSearchNeighbours = 10;
+
+// Минимальный уровень феромона в AS и его вариантах без явных границ
+const double PheromoneFloor = 0.01;
+
+// Попыток выбора по дереву до перехода к линейной рулетке: когда почти весь вес
+// строки приходится на посещённые вершины, выбор по дереву почти всегда отбрасывается
+const int TreeSamplingAttempts = 8;
+
+// Нижний порог общего множителя ленивого испарения (для S и S^α): хранимые
+// значения растут как 1 / S и не должны переполниться в float или double
+const double LazyScaleLimitFloat = 1e-6;
+const double LazyScaleLimitDouble = 1e-100;
+
+// Доля диапазона феромона строки для λ-ветвления: учитываются рёбра с
+// τ >= τmin + λ * (τmax - τmin) по соседям вершины
+const double BranchingLambda = 0.05;
+
+// Выравнивание секций контрольной точки
+const std::size_t CheckpointAlignment = 64;
+
+// Сигнатура файла контрольной точки (8 байт с завершающим нулём)
+const char CheckpointMagic[8] = "ACOCKPT";
+
+// Квадратная матрица n x n, заполненная значением value
+template <typename T>
+void resizeSquare(Matrix<T>& matrix, int n, T value) {
+    matrix.resize(n, n, value);
+}
+
+template <typename T>
+void resizeSquare(SymmetricMatrix<T>& matrix, int n, T value) {
+    matrix.resize(n, value);
+}
+
+// Изменение размера квадратной матрицы с сохранением общей части
+template <typename T>
+void resizeSquarePreserving(Matrix<T>& matrix, int n, T value) {
+    matrix.resizePreserving(n, n, value);
+}
+
+template <typename T>
+void resizeSquarePreserving(SymmetricMatrix<T>& matrix, int n, T value) {
+    matrix.resizePreserving(n, value);
+}
+
+// Строка и столбец последней вершины last переносятся на место vertex
+// (ребро vertex - last пропадает вместе с удаляемой вершиной)
+template <typename M>
+void moveLastEntries(M& matrix, int vertex, int last) {
+    for (int j = 0; j < last; ++j) {
+        if (j != vertex) {
+            matrix(vertex, j) = matrix(last, j);
+            if (!M::Symmetric) {
+                matrix(j, vertex) = matrix(j, last);
+            }
+        }
+    }
+    matrix(vertex, vertex) = matrix(last, last);
+}
+
+// Хранимая часть строки i: вся строка полной матрицы или строка верхнего треугольника
+template <typename T>
+T* storedRow(Matrix<T>& matrix, int i, int& length) {
+    length = matrix.cols();
+    return matrix.row(i);
+}
+
+template <typename T>
+T* storedRow(SymmetricMatrix<T>& matrix, int i, int& length) {
+    length = matrix.rows() - i;
+    return matrix.upperRow(i);
+}
+
+template <typename T>
+const T* storedRow(const Matrix<T>& matrix, int i, int& length) {
+    length = matrix.cols();
+    return matrix.row(i);
+}
+
+template <typename T>
+const T* storedRow(const SymmetricMatrix<T>& matrix, int i, int& length) {
+    length = matrix.rows() - i;
+    return matrix.upperRow(i);
+}
+
+// Вершина, которой соответствует элемент k хранимой части строки i
+template <typename T>
+int storedColumn(const Matrix<T>&, int, int k) {
+    return k;
+}
+
+template <typename T>
+int storedColumn(const SymmetricMatrix<T>&, int i, int k) {
+    return i + k;
+}
+
+// Строка τ^α * η^β для вершины i (векторным ядром по непрерывным участкам строки)
+template <typename T>
+void computeChoiceRow(SimdIsa isa, const Matrix<T>& pheromones, int i, double alpha,
+                      const T* heuristicPowerRow, T* choiceRow) {
+    maskedWeights(isa, pheromones.row(i), heuristicPowerRow, nullptr, pheromones.cols(), alpha, 1.0, choiceRow);
+}
+
+template <typename T>
+void computeChoiceRow(SimdIsa isa, const SymmetricMatrix<T>& pheromones, int i, double alpha,
+                      const T* heuristicPowerRow, T* choiceRow) {
+    // Левее диагонали строка i - это столбец i треугольника, правее - его строка i
+    for (int j = 0; j < i; ++j) {
+        choiceRow[j] = static_cast<T>(std::pow(pheromones(j, i), alpha) * heuristicPowerRow[j]);
+    }
+
+    maskedWeights(isa, pheromones.upperRow(i), heuristicPowerRow + i, nullptr, pheromones.cols() - i,
+                  alpha, 1.0, choiceRow + i);
+}
+
+// Откладывание на одно ребро. Хранимое значение в единицах общего множителя scale
+// (1 без ленивого испарения) приводится к истинному max(floor, τ * scale) и обратно
+template <typename T>
+void depositEdge(T& pheromone, double deltaPheromone, double minPheromone, double maxPheromone, double scale) {
+    double value = std::max(minPheromone, pheromone * scale);
+    pheromone = static_cast<T>(std::min(value + deltaPheromone, maxPheromone) / scale);
+}
+
+// Вклад маршрута в строки [beginRow, endRow). Каждый маршрут содержит ровно одно ребро,
+// выходящее из вершины i, поэтому строка i получает одно приращение на ребро i -> successor[i]
+template <typename T>
+void depositRoute(Matrix<T>& pheromones, const int* successor, double deltaPheromone,
+                  double minPheromone, double maxPheromone, double scale, int beginRow, int endRow) {
+    for (int from = beginRow; from < endRow; ++from) {
+        int to = successor[from];
+
+        if (from != to) {
+            depositEdge(pheromones(from, to), deltaPheromone, minPheromone, maxPheromone, scale);
+        }
+    }
+}
+
+// В треугольнике ребро {i, j} хранится в строке min(i, j): блок просматривает
+// весь маршрут и откладывает только на рёбра своих строк
+template <typename T>
+void depositRoute(SymmetricMatrix<T>& pheromones, const int* successor, double deltaPheromone,
+                  double minPheromone, double maxPheromone, double scale, int beginRow, int endRow) {
+    for (int from = 0; from < pheromones.rows(); ++from) {
+        int to = successor[from];
+        int row = std::min(from, to);
+
+        if (from != to && row >= beginRow && row < endRow) {
+            depositEdge(pheromones(from, to), deltaPheromone, minPheromone, maxPheromone, scale);
+        }
+    }
+}
+
+// Рёбра маршрута, принадлежащие строкам [beginRow, endRow): в полной матрице - рёбра
+// из этих строк, в треугольнике - рёбра, у которых min(from, to) в блоке
+template <typename Pheromones, typename F>
+void forEachRouteEdge(const Pheromones&, const int* successor, int numVertices,
+                      int beginRow, int endRow, F f) {
+    if (Pheromones::Symmetric) {
+        for (int from = 0; from < numVertices; ++from) {
+            int to = successor[from];
+            int row = std::min(from, to);
+            if (from != to && row >= beginRow && row < endRow) {
+                f(from, to);
+            }
+        }
+    } else {
+        for (int from = beginRow; from < endRow; ++from) {
+            if (successor[from] != from) {
+                f(from, successor[from]);
+            }
+        }
+    }
+}
+
+// Начало секции образа: выравнивание конца образа нулями
+CheckpointSection beginSection(std::vector<char>& image) {
+    image.resize((image.size() + CheckpointAlignment - 1) / CheckpointAlignment * CheckpointAlignment, 0);
+    return CheckpointSection{ image.size(), 0 };
+}
+
+void appendBytes(std::vector<char>& image, const void* data, std::size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    image.insert(image.end(), bytes, bytes + size);
+}
+
+void endSection(const std::vector<char>& image, CheckpointSection& section) {
+    section.size = image.size() - section.offset;
+}
+
+// Секция лежит внутри образа и имеет ожидаемый размер
+bool isSectionValid(const CheckpointSection& section, std::size_t imageSize, std::size_t expectedSize) {
+    return section.offset <= imageSize && section.size <= imageSize - section.offset &&
+           section.size == expectedSize && section.offset % CheckpointAlignment == 0;
+}
+
+// Состояние генератора в виде слов. Стандарт задаёт только текстовое
+// представление, поэтому слова извлекаются из него при сохранении.
+void appendRngState(const std::mt19937& engine, std::vector<std::uint32_t>& words) {
+    std::ostringstream out;
+    out << engine;
+
+    std::istringstream in(out.str());
+    std::uint32_t word;
+    while (in >> word) {
+        words.push_back(word);
+    }
+}
+
+// Слов в состоянии одного генератора
+int rngStateWords() {
+    static const int words = []() {
+        std::vector<std::uint32_t> state;
+        appendRngState(std::mt19937(), state);
+        return static_cast<int>(state.size());
+    }();
+    return words;
+}
+
+// Значение перечисления из образа лежит в диапазоне [0, last]
+template <typename E>
+bool isEnumValue(std::int32_t value, E last) {
+    return value >= 0 && value <= static_cast<std::int32_t>(last);
+}
+
+// Симметричность матрицы расстояний
+bool isSymmetric(const Matrix<double>& matrix) {
+    for (int i = 0; i < matrix.rows(); ++i) {
+        for (int j = i + 1; j < matrix.cols(); ++j) {
+            if (matrix(i, j) != matrix(j, i)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool restoreRngState(const std::uint32_t* words, int count, std::mt19937& engine) {
+    std::ostringstream out;
+    for (int i = 0; i < count; ++i) {
+        out << words[i] << ' ';
+    }
+
+    std::istringstream in(out.str());
+    in >> engine;
+    return !in.fail();
+}
+
+} // namespace
+
+AntColony::AntColony(int numVertices, int numAnts, double alpha, double beta,
+                     double rho, double Q, int maxIterations)
+    : numVertices(numVertices), numAnts(numAnts), alpha(alpha), beta(beta),
+    rho(rho), Q(Q), maxIterations(maxIterations), currentIteration(0),
+    metric(DistanceMetric::Euclidean), storageMode(StorageMode::Dense), compactStorage(false), useChoiceInfo(true), candidateListSize(0), numCandidates(0),
+    symmetricDistances(true), simdIsa(detectSimdIsa()), samplingMode(SamplingMode::Scaled), lazyEvaporation(false),
+    pheromoneScale(1.0), lazyFloorWeight(0.0), storedPheromoneMin(0.0), localSearchMode(LocalSearchMode::None),
+    localSearchMoves(LocalSearchTwoOpt | LocalSearchOrOpt), numLocalSearchNeighbours(0),
+    localSearchers(1), variant(AcoVariant::AntSystem), pheromoneMin(PheromoneFloor),
+    pheromoneMax(std::numeric_limits<double>::max()), initialPheromone(1.0), iterationsSinceImprovement(0),
+    bestCost(std::numeric_limits<double>::max()), numThreads(1), requestedThreads(1),
+    restartCount(0), statisticsEnabled(false), localSearchSeconds(1, 0.0)
+{
+    // Инициализация генератора случайных чисел
+    std::random_device rd;
+    rng.seed(rd());
+    seedWorkers();
+
+    // Инициализация муравьёв
+    ants.resize(numAnts, Ant(numVertices));
+}
+
+void AntColony::generateRandomGraph(int width, int height) {
+    vertices.clear();
+    metric = DistanceMetric::Euclidean;
+
+    std::uniform_real_distribution<double> distX(50, width - 50);
+    std::uniform_real_distribution<double> distY(50, height - 50);
+    std::uniform_real_distribution<double> distCost(10.0, 100.0);
+
+    // Генерация вершин со случайными координатами и стоимостями
+    for (int i = 0; i < numVertices; ++i) {
+        Point position(distX(rng), distY(rng));
+        double visitCost = distCost(rng);
+        vertices.emplace_back(i, position, visitCost);
+    }
+
+    // Инициализация рёбер
+    initializeEdges();
+}
+
+void AntColony::setGraph(const std::vector<Vertex>& graphVertices) {
+    metric = DistanceMetric::Euclidean;
+    assignVertices(graphVertices);
+    initializeEdges();
+}
+
+void AntColony::setInstance(const Instance& instance) {
+    metric = instance.metric;
+    assignVertices(instance.vertices);
+
+    // Для EXPLICIT расстояния берутся из файла, а не из координат
+    initializeEdges(metric == DistanceMetric::Explicit ? &instance.explicitDistances : nullptr);
+}
+
+void AntColony::assignVertices(const std::vector<Vertex>& graphVertices) {
+    vertices = graphVertices;
+    numVertices = static_cast<int>(vertices.size());
+
+    // Идентификаторы вершин совпадают с индексами
+    for (int i = 0; i < numVertices; ++i) {
+        vertices[i].id = i;
+    }
+
+    ants.assign(numAnts, Ant(numVertices));
+    bestRoute.clear();
+    bestSuccessor.clear();
+    bestCost = std::numeric_limits<double>::max();
+    currentIteration = 0;
+    iterationsSinceImprovement = 0;
+}
+
+void AntColony::initializeEdges(const Matrix<double>* explicitDistances) {
+    // 2-opt разворачивает участки маршрута и применим только к симметричным расстояниям
+    symmetricDistances = !explicitDistances || isSymmetric(*explicitDistances);
+
+    // Компактное хранение - только для симметричных расстояний. Целочисленные
+    // расстояния хранятся в int32, а если какое-то из них не помещается - во float.
+    compactStorage = storageMode == StorageMode::Compact && symmetricDistances;
+    if (!compactStorage) {
+        fillDistances(DistanceMatrix::Dense, explicitDistances);
+    } else if (!(explicitDistances || isIntegerMetric(metric)) ||
+               !fillDistances(DistanceMatrix::PackedInt, explicitDistances)) {
+        fillDistances(DistanceMatrix::PackedFloat, explicitDistances);
+    }
+
+    // Матрицы другого режима освобождаются
+    if (compactStorage) {
+        denseTrails = DenseTrails();
+        buildHeuristics(compactTrails);
+    } else {
+        compactTrails = CompactTrails();
+        buildHeuristics(denseTrails);
+    }
+
+    buildCandidateLists();
+    computeChoiceInfo();
+}
+
+bool AntColony::fillDistances(DistanceMatrix::Storage storage, const Matrix<double>* explicitDistances) {
+    distances.reset(numVertices, storage);
+
+    // В упакованной форме заполняется только верхний треугольник
+    for (int i = 0; i < numVertices; ++i) {
+        for (int j = distances.isPacked() ? i : 0; j < numVertices; ++j) {
+            double distance = explicitDistances ? (*explicitDistances)(i, j)
+                            : i != j ? calculateDistance(i, j) : 0.0;
+
+            if (storage == DistanceMatrix::PackedInt && !DistanceMatrix::fitsInt(distance)) {
+                return false;
+            }
+            distances.set(i, j, distance);
+        }
+    }
+    return true;
+}
+
+template <typename Trails>
+void AntColony::buildHeuristics(Trails& trails) {
+    using Weight = typename decltype(trails.heuristicPowers)::value_type;
+
+    resizeSquare(trails.pheromones, numVertices, typename decltype(trails.pheromones)::value_type(1));
+    trails.heuristicPowers.resize(numVertices, numVertices, Weight(0));
+
+    // η хранится только для выбора без кэша в полном режиме, в компактном достаточно η^β
+    if (!compactStorage) {
+        trails.heuristics.resize(numVertices, numVertices, Weight(0));
+    }
+
+    for (int i = 0; i < numVertices; ++i) {
+        for (int j = 0; j < numVertices; ++j) {
+            if (i != j) {
+                setHeuristic(trails, i, j);
+            }
+        }
+    }
+}
+
+template <typename Trails>
+void AntColony::setHeuristic(Trails& trails, int from, int to) {
+    using Weight = typename decltype(trails.heuristicPowers)::value_type;
+
+    // Совпадающие вершины (нулевая стоимость) не должны давать деление на ноль
+    double cost = std::max(distances(from, to) + vertices[to].visitCost, 1e-9);
+    double eta = 1.0 / cost;
+    trails.heuristicPowers(from, to) = static_cast<Weight>(std::pow(eta, beta));
+
+    if (!trails.heuristics.empty()) {
+        trails.heuristics(from, to) = static_cast<Weight>(eta);
+    }
+}
+
+std::size_t AntColony::getMatrixBytes() const {
+    return distances.bytes() + withTrails([](const auto& trails) {
+        return trails.pheromones.bytes() + trails.heuristics.bytes() +
+               trails.heuristicPowers.bytes() + trails.choiceInfo.bytes() + trails.samplingTrees.bytes();
+    });
+}
+
+void AntColony::setThreadCount(int threads) {
+    requestedThreads = std::max(1, threads);
+    numThreads = std::min(requestedThreads, numAnts);
+    pool.reset(numThreads > 1 ? new ThreadPool(numThreads) : nullptr);
+    localSearchers.resize(numThreads);
+    localSearchSeconds.assign(numThreads, 0.0);
+    seedWorkers();
+}
+
+void AntColony::setSeed(unsigned int seed) {
+    rng.seed(seed);
+    seedWorkers();
+}
+
+void AntColony::seedWorkers() {
+    // Зёрна потоков берутся из основного генератора
+    workerRngs.clear();
+    for (int worker = 0; worker < numThreads; ++worker) {
+        workerRngs.emplace_back(rng());
+    }
+}
+
+void AntColony::saveState(std::vector<char>& image) const {
+    CheckpointHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, CheckpointMagic, sizeof(header.magic));
+    header.version = CheckpointVersion;
+    header.headerSize = sizeof(CheckpointHeader);
+
+    header.numVertices = numVertices;
+    header.numAnts = numAnts;
+    header.maxIterations = maxIterations;
+    header.currentIteration = currentIteration;
+    header.iterationsSinceImprovement = iterationsSinceImprovement;
+    header.variant = static_cast<std::int32_t>(variant);
+    header.metric = static_cast<std::int32_t>(metric);
+    header.storageMode = static_cast<std::int32_t>(storageMode);
+    header.compactStorage = compactStorage;
+    header.samplingMode = static_cast<std::int32_t>(samplingMode);
+    header.lazyEvaporation = lazyEvaporation;
+    header.candidateListSize = candidateListSize;
+    header.localSearchMode = static_cast<std::int32_t>(localSearchMode);
+    header.localSearchMoves = localSearchMoves;
+    header.rankedAnts = variantParameters.rankedAnts;
+    header.mmasGlobalBest = variantParameters.mmasGlobalBest;
+    header.mmasRestartIterations = variantParameters.mmasRestartIterations;
+    header.alpha = alpha;
+    header.beta = beta;
+    header.rho = rho;
+    header.Q = Q;
+    header.elitistWeight = variantParameters.elitistWeight;
+    header.mmasPBest = variantParameters.mmasPBest;
+    header.acsQ0 = variantParameters.acsQ0;
+    header.acsXi = variantParameters.acsXi;
+
+    header.bestCost = bestCost;
+    header.pheromoneMin = pheromoneMin;
+    header.pheromoneMax = pheromoneMax;
+    header.initialPheromone = initialPheromone;
+    header.pheromoneScale = pheromoneScale;
+    header.storedPheromoneMin = storedPheromoneMin;
+
+    // Буфер очищается без освобождения памяти: повторные сохранения её не выделяют
+    image.assign(sizeof(header), 0);
+
+    header.vertices = beginSection(image);
+    for (const Vertex& vertex : vertices) {
+        const double fields[3] = { vertex.position.x, vertex.position.y, vertex.visitCost };
+        appendBytes(image, fields, sizeof(fields));
+    }
+    endSection(image, header.vertices);
+
+    // Расстояния по координатам пересчитываются при загрузке, сохраняется только матрица EXPLICIT
+    header.distances = beginSection(image);
+    if (metric == DistanceMetric::Explicit) {
+        for (int i = 0; i < numVertices; ++i) {
+            for (int j = 0; j < numVertices; ++j) {
+                double distance = distances(i, j);
+                appendBytes(image, &distance, sizeof(distance));
+            }
+        }
+    }
+    endSection(image, header.distances);
+
+    // Феромоны в формате хранения: строки без выравнивания подряд
+    header.pheromones = beginSection(image);
+    withTrails([&image, this](const auto& trails) {
+        using Scalar = typename std::decay_t<decltype(trails.pheromones)>::value_type;
+
+        for (int i = 0; i < numVertices; ++i) {
+            int length;
+            const Scalar* pheromoneRow = storedRow(trails.pheromones, i, length);
+            appendBytes(image, pheromoneRow, length * sizeof(Scalar));
+        }
+    });
+    endSection(image, header.pheromones);
+
+    header.bestRoute = beginSection(image);
+    if (static_cast<int>(bestRoute.size()) == numVertices) {
+        for (int vertex : bestRoute) {
+            std::int32_t value = vertex;
+            appendBytes(image, &value, sizeof(value));
+        }
+    }
+    endSection(image, header.bestRoute);
+
+    std::vector<std::uint32_t> words;
+    appendRngState(rng, words);
+    header.rngWords = static_cast<std::int32_t>(words.size());
+    for (const std::mt19937& workerRng : workerRngs) {
+        appendRngState(workerRng, words);
+    }
+    header.rngCount = 1 + static_cast<std::int32_t>(workerRngs.size());
+
+    header.rngStates = beginSection(image);
+    appendBytes(image, words.data(), words.size() * sizeof(std::uint32_t));
+    endSection(image, header.rngStates);
+
+    std::memcpy(image.data(), &header, sizeof(header));
+}
+
+bool AntColony::restoreState(const char* data, std::size_t size, std::string& error) {
+    CheckpointHeader header;
+    if (size < sizeof(header)) {
+        error = "truncated checkpoint header";
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+
+    if (std::memcmp(header.magic, CheckpointMagic, sizeof(header.magic)) != 0) {
+        error = "not a checkpoint file";
+        return false;
+    }
+    if (header.version != CheckpointVersion || header.headerSize != sizeof(CheckpointHeader)) {
+        error = "unsupported checkpoint version " + std::to_string(header.version);
+        return false;
+    }
+
+    // Образ полностью проверяется до изменения колонии: при ошибке колония остаётся прежней
+    const int n = header.numVertices;
+    const int moves = LocalSearchTwoOpt | LocalSearchOrOpt;
+    if (n < 2 || header.numAnts <= 0 || header.rngCount < 1 || header.rngWords != rngStateWords() ||
+        header.maxIterations < 0 || header.currentIteration < 0 || header.iterationsSinceImprovement < 0 ||
+        header.iterationsSinceImprovement > header.currentIteration || header.candidateListSize < 0 ||
+        header.rankedAnts < 1 || header.mmasRestartIterations < 0 || (header.localSearchMoves & ~moves) != 0 ||
+        !isEnumValue(header.variant, AcoVariant::AntColonySystem) ||
+        !isEnumValue(header.metric, DistanceMetric::Explicit) ||
+        !isEnumValue(header.storageMode, StorageMode::Compact) ||
+        !isEnumValue(header.samplingMode, SamplingMode::Tree) ||
+        !isEnumValue(header.localSearchMode, LocalSearchMode::AllAnts)) {
+        error = "corrupt checkpoint";
+        return false;
+    }
+
+    const std::size_t count = static_cast<std::size_t>(n);
+    const std::size_t cells = count * count;
+    const bool explicitMetric = header.metric == static_cast<std::int32_t>(DistanceMetric::Explicit);
+    const std::size_t pheromoneBytes = header.compactStorage ? (cells + count) / 2 * sizeof(float)
+                                                             : cells * sizeof(double);
+    const std::size_t routeBytes = header.bestRoute.size == 0 ? 0 : count * sizeof(std::int32_t);
+    const std::size_t rngBytes = static_cast<std::size_t>(header.rngCount) *
+                                 static_cast<std::size_t>(header.rngWords) * sizeof(std::uint32_t);
+
+    if (!isSectionValid(header.vertices, size, count * 3 * sizeof(double)) ||
+        !isSectionValid(header.distances, size, explicitMetric ? cells * sizeof(double) : 0) ||
+        !isSectionValid(header.pheromones, size, pheromoneBytes) ||
+        !isSectionValid(header.bestRoute, size, routeBytes) ||
+        !isSectionValid(header.rngStates, size, rngBytes)) {
+        error = "corrupt checkpoint";
+        return false;
+    }
+
+    // Лучший маршрут - перестановка вершин
+    std::vector<int> route;
+    if (header.bestRoute.size > 0) {
+        const std::int32_t* source = reinterpret_cast<const std::int32_t*>(data + header.bestRoute.offset);
+        std::vector<bool> seen(n, false);
+        route.assign(source, source + n);
+        for (int vertex : route) {
+            if (vertex < 0 || vertex >= n || seen[vertex]) {
+                error = "corrupt checkpoint route";
+                return false;
+            }
+            seen[vertex] = true;
+        }
+    }
+
+    // Генераторы: основной и по одному на поток. Состояния потоков восстанавливаются,
+    // только если потоков столько же, сколько при сохранении.
+    const std::uint32_t* words = reinterpret_cast<const std::uint32_t*>(data + header.rngStates.offset);
+    std::mt19937 restoredRng;
+    std::vector<std::mt19937> restoredWorkers(header.rngCount - 1);
+    bool rngValid = restoreRngState(words, header.rngWords, restoredRng);
+    for (int worker = 0; worker < header.rngCount - 1 && rngValid; ++worker) {
+        rngValid = restoreRngState(words + static_cast<std::size_t>(worker + 1) * header.rngWords,
+                                   header.rngWords, restoredWorkers[worker]);
+    }
+    if (!rngValid) {
+        error = "corrupt random generator state";
+        return false;
+    }
+
+    // Граф: расстояния по координатам, эвристика и списки кандидатов строятся заново.
+    // Секции выровнены по 64 байтам, поэтому массивы читаются прямо из образа.
+    const double* vertexFields = reinterpret_cast<const double*>(data + header.vertices.offset);
+    std::vector<Vertex> graphVertices;
+    graphVertices.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        graphVertices.emplace_back(i, Point(vertexFields[3 * i], vertexFields[3 * i + 1]), vertexFields[3 * i + 2]);
+    }
+
+    Matrix<double> explicitDistances;
+    if (explicitMetric) {
+        const double* source = reinterpret_cast<const double*>(data + header.distances.offset);
+        explicitDistances.resize(n, n);
+        for (int i = 0; i < n; ++i) {
+            std::memcpy(explicitDistances.row(i), source + static_cast<std::size_t>(i) * n, n * sizeof(double));
+        }
+    }
+
+    // Формат феромонов должен совпадать с тем, который выберет initializeEdges
+    const StorageMode restoredStorage = static_cast<StorageMode>(header.storageMode);
+    const bool compact = restoredStorage == StorageMode::Compact && (!explicitMetric || isSymmetric(explicitDistances));
+    if (compact != (header.compactStorage != 0)) {
+        error = "checkpoint storage does not match the instance";
+        return false;
+    }
+
+    // Параметры
+    numAnts = header.numAnts;
+    maxIterations = header.maxIterations;
+    alpha = header.alpha;
+    beta = header.beta;
+    rho = header.rho;
+    Q = header.Q;
+    storageMode = restoredStorage;
+    samplingMode = static_cast<SamplingMode>(header.samplingMode);
+    lazyEvaporation = header.lazyEvaporation != 0;
+    candidateListSize = header.candidateListSize;
+    localSearchMode = static_cast<LocalSearchMode>(header.localSearchMode);
+    localSearchMoves = header.localSearchMoves;
+    variant = static_cast<AcoVariant>(header.variant);
+    variantParameters.elitistWeight = header.elitistWeight;
+    variantParameters.rankedAnts = header.rankedAnts;
+    variantParameters.mmasGlobalBest = header.mmasGlobalBest != 0;
+    variantParameters.mmasPBest = header.mmasPBest;
+    variantParameters.mmasRestartIterations = header.mmasRestartIterations;
+    variantParameters.acsQ0 = header.acsQ0;
+    variantParameters.acsXi = header.acsXi;
+
+    metric = static_cast<DistanceMetric>(header.metric);
+    assignVertices(graphVertices);
+    initializeEdges(explicitMetric ? &explicitDistances : nullptr);
+
+    // Пул и рабочие массивы под новое количество муравьёв
+    setThreadCount(requestedThreads);
+
+    // Феромоны
+    withTrails([&](auto& trails) {
+        using Scalar = typename std::decay_t<decltype(trails.pheromones)>::value_type;
+        const Scalar* source = reinterpret_cast<const Scalar*>(data + header.pheromones.offset);
+
+        for (int i = 0; i < numVertices; ++i) {
+            int length;
+            Scalar* pheromoneRow = storedRow(trails.pheromones, i, length);
+            std::memcpy(pheromoneRow, source, length * sizeof(Scalar));
+            source += length;
+        }
+    });
+
+    currentIteration = header.currentIteration;
+    iterationsSinceImprovement = header.iterationsSinceImprovement;
+    pheromoneMin = header.pheromoneMin;
+    pheromoneMax = header.pheromoneMax;
+    initialPheromone = header.initialPheromone;
+    pheromoneScale = header.pheromoneScale;
+    storedPheromoneMin = header.storedPheromoneMin;
+    updateLazyFloorWeight();
+    computeChoiceInfo();
+
+    if (!route.empty()) {
+        bestRoute.swap(route);
+        bestSuccessor.resize(n);
+        for (int i = 0; i < n; ++i) {
+            bestSuccessor[bestRoute[i]] = bestRoute[(i + 1) % n];
+        }
+        bestCost = header.bestCost;
+    }
+
+    rng = restoredRng;
+    if (header.rngCount - 1 == numThreads) {
+        workerRngs.swap(restoredWorkers);
+    } else {
+        seedWorkers();
+    }
+
+    // Условия завершения отсчитываются заново от продолжения
+    termination.reset();
+    return true;
+}
+
+void AntColony::setSimdIsa(SimdIsa isa) {
+    simdIsa = isSimdIsaSupported(isa) ? isa : SimdIsa::Scalar;
+    computeChoiceInfo();
+}
+
+void AntColony::setSamplingMode(SamplingMode mode) {
+    samplingMode = mode;
+    computeChoiceInfo();
+}
+
+void AntColony::setLazyEvaporation(bool enabled) {
+    // Без ленивого режима множитель равен 1: истинные значения записываются обратно
+    if (lazyEvaporation && !enabled && pheromoneScale != 1.0) {
+        double scale = pheromoneScale;
+        pheromoneScale = 1.0;
+        forEachRowBlock([this, scale](int beginRow, int endRow) {
+            renormalizePheromones(beginRow, endRow, scale, pheromoneMin);
+        });
+    }
+
+    lazyEvaporation = enabled;
+    updateLazyFloorWeight();
+    computeChoiceInfo();
+}
+
+void AntColony::updateLazyFloorWeight() {
+    lazyFloorWeight = lazyEvaporation ? std::pow(pheromoneMin / pheromoneScale, alpha) : 0.0;
+}
+
+void AntColony::setCandidateListSize(int k) {
+    candidateListSize = std::max(0, k);
+    buildCandidateLists();
+
+    // Деревья выбора нужны только при полном переборе
+    computeChoiceInfo();
+}
+
+void AntColony::buildCandidateLists() {
+    numCandidates = std::min(candidateListSize, numVertices - 1);
+    if (numCandidates <= 0 || static_cast<int>(vertices.size()) != numVertices) {
+        numCandidates = 0;
+    }
+
+    buildNeighbourLists(numCandidates, candidates);
+    buildLocalSearchNeighbours();
+}
+
+void AntColony::setLocalSearch(LocalSearchMode mode, int moves) {
+    localSearchMode = mode;
+    localSearchMoves = moves;
+    buildLocalSearchNeighbours();
+}
+
+void AntColony::buildLocalSearchNeighbours() {
+    // Со списками кандидатов локальный поиск использует их же
+    numLocalSearchNeighbours = 0;
+    if (localSearchMode != LocalSearchMode::None && numCandidates == 0 &&
+        static_cast<int>(vertices.size()) == numVertices) {
+        numLocalSearchNeighbours = std::min(LocalSearchNeighbours, numVertices - 1);
+    }
+
+    buildNeighbourLists(numLocalSearchNeighbours, localSearchNeighbours);
+}
+
+void AntColony::buildNeighbourLists(int k, std::vector<int>& lists) const {
+    lists.clear();
+    if (k <= 0) {
+        return;
+    }
+
+    lists.reserve(static_cast<size_t>(numVertices) * k);
+
+    if (isPlanarMetric(metric)) {
+        // Поиск k ближайших соседей через k-d дерево: O(N log N) вместо O(N^2)
+        KdTree tree(vertices);
+        std::vector<int> nearest;
+
+        for (int i = 0; i < numVertices; ++i) {
+            tree.nearest(i, k, nearest);
+            lists.insert(lists.end(), nearest.begin(), nearest.end());
+        }
+    } else {
+        // GEO и EXPLICIT: частичная сортировка строки матрицы расстояний
+        std::vector<int> order(numVertices);
+        std::vector<double> distanceRow(numVertices);
+
+        for (int i = 0; i < numVertices; ++i) {
+            for (int j = 0; j < numVertices; ++j) {
+                order[j] = j;
+                distanceRow[j] = distances(i, j);
+            }
+            std::swap(order[i], order[numVertices - 1]);
+
+            std::partial_sort(order.begin(), order.begin() + k, order.end() - 1,
+                              [&distanceRow](int a, int b) { return distanceRow[a] < distanceRow[b]; });
+            lists.insert(lists.end(), order.begin(), order.begin() + k);
+        }
+    }
+}
+
+void AntColony::setUseChoiceInfo(bool enabled) {
+    useChoiceInfo = enabled;
+    computeChoiceInfo();
+}
+
+void AntColony::computeChoiceInfo() {
+    withTrails([this](auto& trails) {
+        using ChoiceMatrix = std::decay_t<decltype(trails.choiceInfo)>;
+
+        if (!useChoiceInfo || trails.heuristicPowers.empty()) {
+            trails.choiceInfo = ChoiceMatrix();
+            return;
+        }
+
+        if (trails.choiceInfo.rows() != numVertices) {
+            trails.choiceInfo.resize(numVertices, numVertices, 0);
+        }
+
+        if (samplingMode != SamplingMode::Tree || numCandidates > 0 || lazyEvaporation) {
+            trails.samplingTrees = ChoiceMatrix();
+        } else if (trails.samplingTrees.rows() != numVertices) {
+            trails.samplingTrees.resize(numVertices, numVertices, 0);
+        }
+
+        computeChoiceInfo(trails, 0, numVertices);
+    });
+}
+
+void AntColony::computeChoiceInfo(int beginRow, int endRow) {
+    withTrails([&](auto& trails) { computeChoiceInfo(trails, beginRow, endRow); });
+}
+
+template <typename Trails>
+void AntColony::computeChoiceInfo(Trails& trails, int beginRow, int endRow) {
+    using Weight = typename decltype(trails.choiceInfo)::value_type;
+
+    if (trails.choiceInfo.empty()) {
+        return;
+    }
+
+    // τ^α * η^β для всех рёбер; диагональ остаётся нулевой (η^β = 0)
+    for (int i = beginRow; i < endRow; ++i) {
+        computeChoiceRow(simdIsa, trails.pheromones, i, alpha, trails.heuristicPowers.row(i), trails.choiceInfo.row(i));
+    }
+
+    // Деревья строятся один раз за итерацию и читаются всеми муравьями
+    if (!trails.samplingTrees.empty()) {
+        for (int i = beginRow; i < endRow; ++i) {
+            FenwickTree<Weight>(trails.samplingTrees.row(i), numVertices).build(trails.choiceInfo.row(i));
+        }
+    }
+}
+
+void AntColony::reset() {
+    currentIteration = 0;
+    iterationsSinceImprovement = 0;
+    bestCost = std::numeric_limits<double>::max();
+    bestRoute.clear();
+    bestSuccessor.clear();
+    termination.reset();
+    restartCount = 0;
+
+    // Сброс феромонов
+    initializeTrails(1.0);
+}
+
+void AntColony::initializeTrails(double value) {
+    withTrails([value](auto& trails) {
+        trails.pheromones.fill(static_cast<typename decltype(trails.pheromones)::value_type>(value));
+    });
+    pheromoneScale = 1.0;
+    storedPheromoneMin = 0.0;
+    updateLazyFloorWeight();
+    computeChoiceInfo();
+}
+
+void AntColony::setVariant(AcoVariant newVariant, const VariantParameters& parameters) {
+    variant = newVariant;
+    variantParameters = parameters;
+
+    // Границы MMAS пересчитываются по лучшему маршруту, остальные варианты
+    // используют только нижний порог
+    pheromoneMin = variant == AcoVariant::AntColonySystem ? 0.0 : PheromoneFloor;
+    pheromoneMax = std::numeric_limits<double>::max();
+    updateLazyFloorWeight();
+}
+
+void AntColony::runIteration() {
+    if (isFinished()) {
+        notifyFinished();
+        return;
+    }
+    termination.beginIteration();
+
+    std::chrono::steady_clock::time_point iterationStart;
+    std::size_t allocationsBefore = 0;
+    if (statisticsEnabled) {
+        statistics = IterationStatistics();
+        localSearchSeconds.assign(numThreads, 0.0);
+        allocationsBefore = allocationCounter ? allocationCounter() : 0;
+        iterationStart = std::chrono::steady_clock::now();
+    }
+
+    // ACS: начальный феромон τ0 = Q / (N * L_nn) по маршруту ближайшего соседа
+    if (variant == AcoVariant::AntColonySystem && currentIteration == 0) {
+        initialPheromone = Q / (numVertices * nearestNeighbourCost());
+        initializeTrails(initialPheromone);
+    }
+
+    // Каждый муравей строит маршрут (маршруты независимы при фиксированных феромонах).
+    // В ACS локальное обновление связывает муравьёв, поэтому они строят маршруты по очереди.
+    measurePhase(statistics.constructionSeconds, [this]() {
+        if (pool && variant != AcoVariant::AntColonySystem) {
+            pool->run([this](int worker) { constructAntSolutions(worker, numThreads); });
+        } else {
+            constructAntSolutions(0, 1);
+        }
+    });
+
+    // Локальный поиск всех муравьёв входит в построение: из него вычитается
+    // время самого долгого потока
+    if (statisticsEnabled && localSearchMode == LocalSearchMode::AllAnts) {
+        statistics.localSearchSeconds = *std::max_element(localSearchSeconds.begin(), localSearchSeconds.end());
+        statistics.constructionSeconds = std::max(0.0, statistics.constructionSeconds - statistics.localSearchSeconds);
+    }
+
+    // Локальный поиск только для лучшего маршрута итерации
+    if (localSearchMode == LocalSearchMode::IterationBest) {
+        measurePhase(statistics.localSearchSeconds, [this]() {
+            auto iterationBest = std::min_element(ants.begin(), ants.end(), [](const Ant& a, const Ant& b) {
+                return a.totalCost < b.totalCost;
+            });
+            improveAntSolution(*iterationBest, localSearchers[0]);
+        });
+    }
+
+    // Обновление лучшего решения после параллельной фазы. Маршрут муравья до
+    // следующей итерации не нужен, поэтому он обменивается с лучшим без копирования;
+    // successor остаётся у муравья для откладывания феромонов и копируется.
+    ++iterationsSinceImprovement;
+    auto iterationBest = std::min_element(ants.begin(), ants.end(), [](const Ant& a, const Ant& b) {
+        return a.totalCost < b.totalCost;
+    });
+    if (iterationBest != ants.end() && iterationBest->totalCost < bestCost) {
+        bestCost = iterationBest->totalCost;
+        bestRoute.swap(iterationBest->route);
+        bestSuccessor.assign(iterationBest->successor.begin(), iterationBest->successor.end());
+        iterationsSinceImprovement = 0;
+    }
+
+    // Обновление феромонов
+    updatePheromones();
+
+    currentIteration++;
+    restartIfStagnated();
+    termination.endIteration(currentIteration, maxIterations, bestCost);
+
+    if (statisticsEnabled) {
+        statistics.iteration = currentIteration;
+        statistics.iterationSeconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - iterationStart).count();
+        if (statistics.constructionSeconds > 0.0) {
+            statistics.stepsPerSecond = static_cast<double>(numAnts) * (numVertices - 1) / statistics.constructionSeconds;
+        }
+        if (allocationCounter) {
+            statistics.allocations = static_cast<long long>(allocationCounter() - allocationsBefore);
+        }
+        collectConvergenceStatistics();
+
+        lastStatistics = statistics;
+        if (statisticsCollected) {
+            statisticsCollected(lastStatistics);
+        }
+    }
+
+    notifyIterationCompleted();
+
+    if (isFinished()) {
+        notifyFinished();
+    }
+}
+
+TerminationReason AntColony::getTerminationReason() const {
+    if (termination.getReason() != TerminationReason::None) {
+        return termination.getReason();
+    }
+    return currentIteration >= maxIterations ? TerminationReason::IterationLimit : TerminationReason::None;
+}
+
+void AntColony::restartIfStagnated() {
+    const RestartParameters& p = restartParameters;
+    if ((p.minBranching <= 0.0 && p.minDiversity <= 0.0) || p.checkInterval <= 0 ||
+        currentIteration % p.checkInterval != 0) {
+        return;
+    }
+
+    bool stagnated = false;
+    if (p.minBranching > 0.0) {
+        double branching, entropy;
+        measureConvergence(branching, entropy);
+        stagnated = branching < p.minBranching;
+    }
+    if (!stagnated && p.minDiversity > 0.0) {
+        stagnated = measureDiversity() < p.minDiversity;
+    }
+    if (!stagnated) {
+        return;
+    }
+
+    // Начальный уровень варианта: τmax в MMAS, τ0 в ACS, иначе 1
+    double value = variant == AcoVariant::MaxMinAntSystem ? pheromoneMax
+                 : variant == AcoVariant::AntColonySystem ? initialPheromone
+                 : 1.0;
+    initializeTrails(value);
+    ++restartCount;
+}
+
+void AntColony::run() {
+    while (!isFinished()) {
+        runIteration();
+    }
+}
+
+bool AntColony::importRoute(const std::vector<int>& route) {
+    if (static_cast<int>(route.size()) != numVertices || numVertices < 2) {
+        return false;
+    }
+
+    // Как у муравьёв: стоимость посещения стартовой вершины в маршрут не входит
+    double cost = calculateRouteCost(route) - vertices[route[0]].visitCost;
+    importedSuccessor.resize(numVertices);
+    for (int i = 0; i < numVertices; ++i) {
+        importedSuccessor[route[i]] = route[(i + 1) % numVertices];
+    }
+
+    bool improved = cost < bestCost;
+    if (improved) {
+        bestCost = cost;
+        bestRoute = route;
+        bestSuccessor = importedSuccessor;
+        iterationsSinceImprovement = 0;
+    }
+
+    // ACS откладывает феромон только на лучший маршрут - это сделает следующее
+    // глобальное обновление. Маршрут один, поэтому откладывание выполняется без пула.
+    if (variant != AcoVariant::AntColonySystem) {
+        deposits.clear();
+        deposits.emplace_back(importedSuccessor.data(), Q / cost);
+        depositPheromones(0, numVertices);
+        refreshDepositedWeights(0, numVertices);
+    }
+
+    return improved;
+}
+
+void AntColony::blendPheromones(const Matrix<double>& target, double weight) {
+    withTrails([&](auto& trails) {
+        using Scalar = typename decltype(trails.pheromones)::value_type;
+
+        for (int i = 0; i < numVertices; ++i) {
+            int length;
+            Scalar* pheromoneRow = storedRow(trails.pheromones, i, length);
+
+            for (int k = 0; k < length; ++k) {
+                int j = storedColumn(trails.pheromones, i, k);
+                if (i == j) {
+                    continue;
+                }
+
+                double value = lazyEvaporation ? std::max(pheromoneMin, pheromoneRow[k] * pheromoneScale) : pheromoneRow[k];
+                value = (1.0 - weight) * value + weight * target(i, j);
+                pheromoneRow[k] = static_cast<Scalar>(std::min(std::max(value, pheromoneMin), pheromoneMax));
+            }
+        }
+    });
+
+    // Значения приведены к истинным, общий множитель снова равен 1
+    pheromoneScale = 1.0;
+    storedPheromoneMin = 0.0;
+    updateLazyFloorWeight();
+    computeChoiceInfo();
+}
+
+int AntColony::addVertex(const Point& position, double visitCost) {
+    if (metric == DistanceMetric::Explicit || numVertices < 2 || static_cast<int>(vertices.size()) != numVertices) {
+        return -1;
+    }
+
+    double previousCost = bestCost;
+    int vertex = numVertices;
+    vertices.emplace_back(vertex, position, visitCost);
+    resizeGraph(numVertices + 1);
+
+    fillVertexDistances(vertex);
+    updateVertexHeuristics(vertex, true);
+    inheritPheromones(vertex);
+    updateNeighbourLists(vertex);
+    insertIntoBestRoute(vertex);
+    finishGraphChange(vertex, previousCost);
+    return vertex;
+}
+
+bool AntColony::removeVertex(int vertex) {
+    if (vertex < 0 || vertex >= numVertices || numVertices <= 2 ||
+        static_cast<int>(vertices.size()) != numVertices) {
+        return false;
+    }
+
+    double previousCost = bestCost;
+    int last = numVertices - 1;
+    detachFromBestRoute(vertex);
+
+    // Последняя вершина занимает место удалённой, поэтому переносятся только её
+    // строка и столбец, а не все строки после удалённой
+    moveLastVertex(vertex);
+    vertices.pop_back();
+    resizeGraph(last);
+
+    for (int& routeVertex : bestRoute) {
+        if (routeVertex == last) {
+            routeVertex = vertex;
+        }
+    }
+    removeFromNeighbourLists(vertex, last);
+    finishGraphChange(-1, previousCost);
+    return true;
+}
+
+bool AntColony::moveVertex(int vertex, const Point& position) {
+    if (vertex < 0 || vertex >= numVertices || metric == DistanceMetric::Explicit ||
+        static_cast<int>(vertices.size()) != numVertices) {
+        return false;
+    }
+
+    // Вершина вынимается из лучшего маршрута и вставляется заново на новом месте
+    double previousCost = bestCost;
+    detachFromBestRoute(vertex);
+    vertices[vertex].position = position;
+
+    fillVertexDistances(vertex);
+    updateVertexHeuristics(vertex, true);
+    inheritPheromones(vertex);
+    updateNeighbourLists(vertex);
+    insertIntoBestRoute(vertex);
+    finishGraphChange(vertex, previousCost);
+    return true;
+}
+
+bool AntColony::setVisitCost(int vertex, double visitCost) {
+    if (vertex < 0 || vertex >= numVertices || static_cast<int>(vertices.size()) != numVertices) {
+        return false;
+    }
+
+    // Стоимость посещения входит в η рёбер, ведущих в вершину, и в стоимость
+    // любого маршрута одинаково, поэтому маршрут и феромоны остаются прежними
+    double previousCost = bestCost;
+    vertices[vertex].visitCost = visitCost;
+    updateVertexHeuristics(vertex, false);
+    finishGraphChange(vertex, previousCost);
+    return true;
+}
+
+void AntColony::resizeGraph(int n) {
+    numVertices = n;
+    distances.resizePreserving(n);
+    withTrails([n](auto& trails) {
+        using Scalar = typename decltype(trails.pheromones)::value_type;
+        using Weight = typename decltype(trails.heuristicPowers)::value_type;
+
+        resizeSquarePreserving(trails.pheromones, n, Scalar(1));
+        trails.heuristicPowers.resizePreserving(n, n, Weight(0));
+        if (!trails.heuristics.empty()) {
+            trails.heuristics.resizePreserving(n, n, Weight(0));
+        }
+        if (!trails.choiceInfo.empty()) {
+            trails.choiceInfo.resizePreserving(n, n, Weight(0));
+        }
+    });
+
+    ants.assign(numAnts, Ant(n));
+}
+
+void AntColony::fillVertexDistances(int vertex) {
+    // Метрики с координатами симметричны: d(j, vertex) = d(vertex, j)
+    for (int j = 0; j < numVertices; ++j) {
+        double distance = j != vertex ? calculateDistance(vertex, j) : 0.0;
+
+        if (distances.getStorage() == DistanceMatrix::PackedInt && !DistanceMatrix::fitsInt(distance)) {
+            // Расстояние не помещается в int32: вся матрица переходит во float
+            fillDistances(DistanceMatrix::PackedFloat, nullptr);
+            return;
+        }
+        distances.set(vertex, j, distance);
+        if (!distances.isPacked()) {
+            distances.set(j, vertex, distance);
+        }
+    }
+}
+
+void AntColony::updateVertexHeuristics(int vertex, bool row) {
+    // Столбец меняется всегда (стоимость посещения и расстояния до вершины), строка - при смене координат
+    withTrails([&](auto& trails) {
+        for (int i = 0; i < numVertices; ++i) {
+            if (i != vertex) {
+                setHeuristic(trails, i, vertex);
+                if (row) {
+                    setHeuristic(trails, vertex, i);
+                }
+            }
+        }
+    });
+}
+
+void AntColony::inheritPheromones(int vertex) {
+    // Ближайший сосед на новом месте
+    int source = -1;
+    for (int j = 0; j < numVertices; ++j) {
+        if (j != vertex && (source < 0 || distances(vertex, j) < distances(vertex, source))) {
+            source = j;
+        }
+    }
+
+    // Вершина получает феромоны соседа, а ребро к нему - самый сильный феромон
+    // соседа: муравьи сначала ведут себя так, будто вершина стоит на его месте
+    withTrails([&](auto& trails) {
+        using Scalar = typename decltype(trails.pheromones)::value_type;
+        auto& pheromones = trails.pheromones;
+        const bool symmetric = std::decay_t<decltype(pheromones)>::Symmetric;
+
+        Scalar strongest = Scalar(0);
+        for (int j = 0; j < numVertices; ++j) {
+            if (j == vertex || j == source) {
+                continue;
+            }
+            strongest = std::max(strongest, pheromones(source, j));
+            pheromones(vertex, j) = pheromones(source, j);
+            if (!symmetric) {
+                pheromones(j, vertex) = pheromones(j, source);
+            }
+        }
+
+        if (strongest > Scalar(0)) {
+            pheromones(vertex, source) = strongest;
+            if (!symmetric) {
+                pheromones(source, vertex) = strongest;
+            }
+        }
+    });
+}
+
+void AntColony::moveLastVertex(int vertex) {
+    int last = numVertices - 1;
+    if (vertex == last) {
+        return;
+    }
+
+    vertices[vertex] = vertices[last];
+    vertices[vertex].id = vertex;
+
+    for (int j = 0; j < last; ++j) {
+        if (j != vertex) {
+            distances.set(vertex, j, distances(last, j));
+            if (!distances.isPacked()) {
+                distances.set(j, vertex, distances(j, last));
+            }
+        }
+    }
+
+    withTrails([vertex, last](auto& trails) {
+        moveLastEntries(trails.pheromones, vertex, last);
+        moveLastEntries(trails.heuristicPowers, vertex, last);
+        if (!trails.heuristics.empty()) {
+            moveLastEntries(trails.heuristics, vertex, last);
+        }
+        if (!trails.choiceInfo.empty()) {
+            moveLastEntries(trails.choiceInfo, vertex, last);
+        }
+    });
+}
+
+double AntColony::neighbourDistance(int from, int to) const {
+    // Тот же порядок, что при построении: по координатам для плоских метрик
+    if (isPlanarMetric(metric)) {
+        double dx = vertices[from].position.x - vertices[to].position.x;
+        double dy = vertices[from].position.y - vertices[to].position.y;
+        return dx * dx + dy * dy;
+    }
+    return distances(from, to);
+}
+
+void AntColony::fillNeighbourList(int vertex, int k, int* list) {
+    neighbourBuffer.clear();
+    for (int j = 0; j < numVertices; ++j) {
+        if (j != vertex) {
+            neighbourBuffer.emplace_back(neighbourDistance(vertex, j), j);
+        }
+    }
+
+    std::partial_sort(neighbourBuffer.begin(), neighbourBuffer.begin() + k, neighbourBuffer.end());
+    for (int c = 0; c < k; ++c) {
+        list[c] = neighbourBuffer[c].second;
+    }
+}
+
+bool AntColony::hasExpectedListSizes() const {
+    // Размеры списков при новом N (иначе списки строятся заново)
+    int expectedCandidates = std::max(0, std::min(candidateListSize, numVertices - 1));
+    int expectedNeighbours = localSearchMode != LocalSearchMode::None && expectedCandidates == 0
+                           ? std::min(LocalSearchNeighbours, numVertices - 1) : 0;
+    return expectedCandidates == numCandidates && expectedNeighbours == numLocalSearchNeighbours;
+}
+
+void AntColony::updateNeighbourLists(int vertex) {
+    if (!hasExpectedListSizes()) {
+        buildCandidateLists();
+        return;
+    }
+
+    // Вершина (новая или перемещённая) входит в списки, где она ближе последнего
+    // соседа; списки, в которых она была, строятся заново
+    auto update = [this, vertex](std::vector<int>& lists, int k) {
+        if (k <= 0) {
+            return;
+        }
+        lists.resize(static_cast<size_t>(numVertices) * k);
+
+        for (int i = 0; i < numVertices; ++i) {
+            int* list = lists.data() + static_cast<size_t>(i) * k;
+            if (i == vertex || std::find(list, list + k, vertex) != list + k) {
+                fillNeighbourList(i, k, list);
+                continue;
+            }
+
+            double distance = neighbourDistance(i, vertex);
+            if (distance < neighbourDistance(i, list[k - 1])) {
+                int position = k - 1;
+                for (; position > 0 && neighbourDistance(i, list[position - 1]) > distance; --position) {
+                    list[position] = list[position - 1];
+                }
+                list[position] = vertex;
+            }
+        }
+    };
+
+    update(candidates, numCandidates);
+    update(localSearchNeighbours, numLocalSearchNeighbours);
+}
+
+void AntColony::removeFromNeighbourLists(int vertex, int last) {
+    if (!hasExpectedListSizes()) {
+        buildCandidateLists();
+        return;
+    }
+
+    // Список последней вершины переходит на место удалённой, номер last в списках
+    // заменяется на vertex, а списки, содержавшие удалённую вершину, строятся заново
+    auto update = [this, vertex, last](std::vector<int>& lists, int k) {
+        if (k <= 0) {
+            return;
+        }
+        if (vertex != last) {
+            std::copy(lists.begin() + static_cast<size_t>(last) * k, lists.begin() + static_cast<size_t>(last + 1) * k,
+                      lists.begin() + static_cast<size_t>(vertex) * k);
+        }
+        lists.resize(static_cast<size_t>(numVertices) * k);
+
+        for (int i = 0; i < numVertices; ++i) {
+            int* list = lists.data() + static_cast<size_t>(i) * k;
+            bool stale = false;
+            for (int c = 0; c < k; ++c) {
+                if (list[c] == vertex) {
+                    stale = true;
+                } else if (list[c] == last) {
+                    list[c] = vertex;
+                }
+            }
+            if (stale) {
+                fillNeighbourList(i, k, list);
+            }
+        }
+    };
+
+    update(candidates, numCandidates);
+    update(localSearchNeighbours, numLocalSearchNeighbours);
+}
+
+void AntColony::detachFromBestRoute(int vertex) {
+    auto position = std::find(bestRoute.begin(), bestRoute.end(), vertex);
+    if (position != bestRoute.end()) {
+        bestRoute.erase(position);
+    }
+}
+
+void AntColony::insertIntoBestRoute(int vertex) {
+    if (bestRoute.empty()) {
+        return;
+    }
+
+    // Самое дешёвое место: ребро a -> b, которое заменяется на a -> vertex -> b
+    // (стоимость посещения vertex от места не зависит)
+    size_t bestPosition = 0;
+    double bestDelta = std::numeric_limits<double>::max();
+    for (size_t p = 0; p < bestRoute.size(); ++p) {
+        int a = bestRoute[p];
+        int b = bestRoute[(p + 1) % bestRoute.size()];
+        double delta = distances(a, vertex) + distances(vertex, b) - distances(a, b);
+        if (delta < bestDelta) {
+            bestDelta = delta;
+            bestPosition = p + 1;
+        }
+    }
+    bestRoute.insert(bestRoute.begin() + bestPosition, vertex);
+}
+
+void AntColony::setMaxIterations(int iterations) {
+    maxIterations = iterations;
+    if (maxIterations > currentIteration) {
+        termination.clearIterationLimit();
+    }
+}
+
+void AntColony::finishGraphChange(int vertex, double previousCost) {
+    // Исправленный лучший маршрут доводится локальным поиском, если он включён
+    if (!bestRoute.empty()) {
+        if (localSearchMode != LocalSearchMode::None) {
+            const int* neighbours = numCandidates > 0 ? candidates.data() : localSearchNeighbours.data();
+            int k = numCandidates > 0 ? numCandidates : numLocalSearchNeighbours;
+            localSearchers[0].improve(bestRoute, distances, neighbours, k, symmetricDistances, localSearchMoves);
+        }
+
+        // Как у муравьёв: стоимость посещения стартовой вершины в маршрут не входит
+        bestCost = calculateRouteCost(bestRoute) - vertices[bestRoute[0]].visitCost;
+        bestSuccessor.resize(numVertices);
+        for (int i = 0; i < numVertices; ++i) {
+            bestSuccessor[bestRoute[i]] = bestRoute[(i + 1) % numVertices];
+        }
+    }
+    iterationsSinceImprovement = 0;
+    termination.restartImprovement(bestCost);
+
+    // Вклады Q / L и границы MMAS обратно пропорциональны длине маршрута,
+    // поэтому уровни феромона масштабируются на L_old / L_new
+    double factor = !bestRoute.empty() && bestCost > 0.0 ? previousCost / bestCost : 1.0;
+    if (variant == AcoVariant::MaxMinAntSystem && pheromoneMax < std::numeric_limits<double>::max()) {
+        pheromoneMin *= factor;
+        pheromoneMax *= factor;
+    }
+    if (variant == AcoVariant::AntColonySystem) {
+        initialPheromone *= factor;
+    }
+
+    // При ленивом испарении масштаб - это общий множитель S, и пересчитываются
+    // только веса изменившихся строки и столбца
+    if (lazyEvaporation && variant != AcoVariant::AntColonySystem) {
+        pheromoneScale *= factor;
+        updateLazyFloorWeight();
+
+        withTrails([&](auto& trails) {
+            if (vertex < 0 || trails.choiceInfo.empty()) {
+                return;
+            }
+            computeChoiceInfo(trails, vertex, vertex + 1);
+            for (int i = 0; i < numVertices; ++i) {
+                if (i != vertex) {
+                    double weight = std::pow(trails.pheromones(i, vertex), alpha);
+                    updateChoiceWeight(trails, i, vertex, weight * trails.heuristicPowers(i, vertex));
+                }
+            }
+        });
+        return;
+    }
+
+    if (factor != 1.0) {
+        forEachRowBlock([this, factor](int beginRow, int endRow) {
+            renormalizePheromones(beginRow, endRow, factor, pheromoneMin);
+        });
+    }
+    computeChoiceInfo();
+}
+
+void AntColony::notifyIterationCompleted() {
+    if (iterationCompleted) {
+        iterationCompleted(currentIteration, bestCost);
+    }
+}
+
+void AntColony::notifyFinished() {
+    if (algorithmFinished) {
+        algorithmFinished();
+    }
+}
+
+void AntColony::constructAntSolutions(int worker, int workers) {
+    int begin, end;
+    ThreadPool::splitRange(numAnts, workers, worker, begin, end);
+
+    std::mt19937& workerRng = workerRngs[worker];
+    std::uniform_int_distribution<int> distStart(0, numVertices - 1);
+
+    for (int i = begin; i < end; ++i) {
+        // Случайная стартовая вершина
+        int startVertex = distStart(workerRng);
+
+        ants[i].reset(startVertex);
+        constructAntSolution(ants[i], workerRng);
+
+        if (localSearchMode == LocalSearchMode::AllAnts) {
+            measurePhase(localSearchSeconds[worker], [&]() { improveAntSolution(ants[i], localSearchers[worker]); });
+        }
+    }
+}
+
+void AntColony::improveAntSolution(Ant& ant, LocalSearch& search) {
+    const int* neighbours = numCandidates > 0 ? candidates.data() : localSearchNeighbours.data();
+    int k = numCandidates > 0 ? numCandidates : numLocalSearchNeighbours;
+
+    // Стартовая вершина остаётся первой, поэтому стоимость меняется ровно на приращение ходов
+    double delta = search.improve(ant.route, distances, neighbours, k, symmetricDistances, localSearchMoves);
+    if (delta < 0.0) {
+        ant.totalCost += delta;
+        ant.linkRoute();
+    }
+}
+
+void AntColony::constructAntSolution(Ant& ant, std::mt19937& rng) {
+    // Построение маршрута для одного муравья
+    while (ant.route.size() < static_cast<size_t>(numVertices)) {
+        int nextVertex = selectNextVertex(ant, rng);
+
+        // Добавление стоимости ребра
+        double edgeDistance = getDistance(ant.currentVertex, nextVertex);
+        ant.totalCost += edgeDistance;
+
+        // Переход к следующей вершине
+        ant.visit(nextVertex);
+
+        // Добавление стоимости посещения вершины
+        ant.totalCost += vertices[nextVertex].visitCost;
+
+        if (variant == AcoVariant::AntColonySystem) {
+            localPheromoneUpdate(ant.route[ant.route.size() - 2], nextVertex);
+        }
+    }
+
+    // Возврат к стартовой вершине
+    ant.totalCost += getDistance(ant.currentVertex, ant.route[0]);
+    ant.linkRoute();
+
+    if (variant == AcoVariant::AntColonySystem && numVertices > 1) {
+        localPheromoneUpdate(ant.currentVertex, ant.route[0]);
+    }
+}
+
+template <typename Trails>
+double AntColony::choiceWeight(const Trails& trails, int from, int to) const {
+    if (lazyEvaporation) {
+        // Вес в единицах S^α; ребро, испарившееся ниже τmin, получает вес нижней границы
+        double heuristicPower = trails.heuristicPowers(from, to);
+        if (useChoiceInfo) {
+            return std::max<double>(trails.choiceInfo(from, to), lazyFloorWeight * heuristicPower);
+        }
+        return std::pow(std::max<double>(trails.pheromones(from, to), pheromoneMin / pheromoneScale), alpha) * heuristicPower;
+    }
+
+    if (useChoiceInfo) {
+        return trails.choiceInfo(from, to);
+    }
+    return std::pow(trails.pheromones(from, to), alpha) * trails.heuristicPowers(from, to);
+}
+
+template <typename Trails>
+int AntColony::selectFromCandidates(const Trails& trails, const Ant& ant, std::mt19937& rng) {
+    const int* candidateRow = getCandidates(ant.currentVertex);
+    double sumProbabilities = 0.0;
+
+    // Сумма весов непосещённых кандидатов
+    for (int c = 0; c < numCandidates; ++c) {
+        int vertex = candidateRow[c];
+        if (!ant.visited[vertex]) {
+            sumProbabilities += choiceWeight(trails, ant.currentVertex, vertex);
+        }
+    }
+
+    // Все кандидаты посещены - выбираем лучшую из оставшихся вершин
+    if (sumProbabilities <= 0.0) {
+        return selectBestNextVertex(trails, ant);
+    }
+
+    // Рулетка по кандидатам без нормализации: случайное число масштабируется суммой
+    std::uniform_real_distribution<double> dist(0.0, sumProbabilities);
+    double random = dist(rng);
+    double cumulative = 0.0;
+    int last = -1;
+
+    for (int c = 0; c < numCandidates; ++c) {
+        int vertex = candidateRow[c];
+        if (!ant.visited[vertex]) {
+            cumulative += choiceWeight(trails, ant.currentVertex, vertex);
+            last = vertex;
+            if (random <= cumulative) {
+                return vertex;
+            }
+        }
+    }
+
+    return last;
+}
+
+template <typename Trails>
+int AntColony::selectBestCandidate(const Trails& trails, const Ant& ant) const {
+    if (numCandidates == 0) {
+        return selectBestNextVertex(trails, ant);
+    }
+
+    // Непосещённый кандидат с наибольшим τ^α * η^β
+    const int* candidateRow = getCandidates(ant.currentVertex);
+    int best = -1;
+    double bestWeight = -1.0;
+
+    for (int c = 0; c < numCandidates; ++c) {
+        int vertex = candidateRow[c];
+        if (!ant.visited[vertex]) {
+            double weight = choiceWeight(trails, ant.currentVertex, vertex);
+            if (weight > bestWeight) {
+                bestWeight = weight;
+                best = vertex;
+            }
+        }
+    }
+
+    return best >= 0 ? best : selectBestNextVertex(trails, ant);
+}
+
+template <typename Trails>
+int AntColony::selectBestNextVertex(const Trails& trails, const Ant& ant) const {
+    int best = -1;
+    double bestWeight = -1.0;
+
+    // Перебор оставшихся вершин: непосещённая вершина с наибольшим τ^α * η^β
+    for (int i : ant.unvisited) {
+        double weight = choiceWeight(trails, ant.currentVertex, i);
+        if (weight > bestWeight) {
+            bestWeight = weight;
+            best = i;
+        }
+    }
+
+    return best;
+}
+
+int AntColony::selectNextVertex(Ant& ant, std::mt19937& rng) {
+    return withTrails([&](const auto& trails) { return selectNextVertex(trails, ant, rng); });
+}
+
+template <typename Trails>
+int AntColony::selectNextVertex(const Trails& trails, Ant& ant, std::mt19937& rng) {
+    // ACS: с вероятностью q0 выбирается лучшее ребро, иначе - рулетка
+    if (variant == AcoVariant::AntColonySystem) {
+        std::uniform_real_distribution<double> exploit(0.0, 1.0);
+        if (exploit(rng) < variantParameters.acsQ0) {
+            return selectBestCandidate(trails, ant);
+        }
+    }
+
+    if (numCandidates > 0) {
+        return selectFromCandidates(trails, ant, rng);
+    }
+
+    if (!trails.samplingTrees.empty()) {
+        int vertex = sampleFromTree(trails, ant, rng);
+        if (vertex >= 0) {
+            return vertex;
+        }
+    }
+
+    // Веса непосещённых вершин (посещённые получают 0) и их сумма за один проход по строке
+    using Weight = typename decltype(trails.choiceInfo)::value_type;
+    Weight* weights = ant.weightBuffer<Weight>();
+    const char* visited = ant.visited.data();
+    double sumProbabilities = 0.0;
+
+    if (useChoiceInfo && !lazyEvaporation) {
+        // Вероятности τ^α * η^β уже посчитаны для текущей итерации
+        sumProbabilities = maskedWeights(simdIsa, trails.choiceInfo.row(ant.currentVertex), nullptr, visited,
+                                         numVertices, 1.0, 1.0, weights);
+    } else if (lazyEvaporation || std::decay_t<decltype(trails.pheromones)>::Symmetric) {
+        // Строка феромонов треугольника не непрерывна, а нижняя граница ленивого
+        // испарения применяется к каждому ребру: τ^α * η^β по элементам
+        for (int i = 0; i < numVertices; ++i) {
+            weights[i] = visited[i] ? Weight(0) : static_cast<Weight>(choiceWeight(trails, ant.currentVertex, i));
+            sumProbabilities += weights[i];
+        }
+    } else if constexpr (!std::decay_t<decltype(trails.pheromones)>::Symmetric) {
+        // Вероятность выбора вершины: τ^α * η^β по строкам феромона и
+        // эвристики (обратной величины общей стоимости) текущей вершины
+        sumProbabilities = maskedWeights(simdIsa, trails.pheromones.row(ant.currentVertex),
+                                         trails.heuristics.row(ant.currentVertex), visited,
+                                         numVertices, alpha, beta, weights);
+    }
+
+    // Непосещённых вершин нет или веса всех нулевые
+    if (sumProbabilities <= 0.0) {
+        return selectBestNextVertex(trails, ant);
+    }
+
+    // Выбор следующей вершины методом рулетки. Без нормализации случайное
+    // число масштабируется суммой, и веса не нужно делить на неё.
+    bool normalize = samplingMode == SamplingMode::Normalized;
+    std::uniform_real_distribution<double> dist(0.0, normalize ? 1.0 : sumProbabilities);
+    double random = dist(rng);
+    double cumulative = 0.0;
+    int last = -1;
+
+    for (int i = 0; i < numVertices; ++i) {
+        if (!visited[i]) {
+            cumulative += normalize ? weights[i] / sumProbabilities : weights[i];
+            last = i;
+            if (random <= cumulative) {
+                return i;
+            }
+        }
+    }
+
+    return last;
+}
+
+template <typename Trails>
+int AntColony::sampleFromTree(const Trails& trails, const Ant& ant, std::mt19937& rng) const {
+    using Weight = typename decltype(trails.choiceInfo)::value_type;
+
+    // Дерево строки общее для всех муравьёв и содержит веса и посещённых вершин:
+    // выпавшая посещённая вершина отбрасывается. Повторный выбор даёт то же
+    // распределение по непосещённым вершинам, что и линейная рулетка.
+    FenwickTree<const Weight> tree(trails.samplingTrees.row(ant.currentVertex), numVertices);
+    const Weight* choiceRow = trails.choiceInfo.row(ant.currentVertex);
+    double total = tree.total();
+    if (total <= 0.0) {
+        return -1;
+    }
+
+    std::uniform_real_distribution<double> dist(0.0, total);
+    for (int attempt = 0; attempt < TreeSamplingAttempts; ++attempt) {
+        int vertex = tree.find(dist(rng));
+        if (!ant.visited[vertex] && choiceRow[vertex] > 0) {
+            return vertex;
+        }
+    }
+
+    // Непосещённым вершинам достаётся малая доля веса - линейная рулетка
+    return -1;
+}
+
+void AntColony::updatePheromones() {
+    // ACS обновляет только рёбра лучшего маршрута
+    if (variant == AcoVariant::AntColonySystem) {
+        measurePhase(statistics.depositSeconds, [this]() { globalPheromoneUpdate(); });
+        return;
+    }
+
+    prepareDeposits();
+    updatePheromoneBounds();
+
+    // Испарение, откладывание и пересчёт кэша выполняются по блокам строк:
+    // каждый поток владеет своими строками матрицы, поэтому атомарные операции
+    // не нужны, а порядок сложения в каждой ячейке (по порядку вкладов)
+    // не зависит от количества потоков.
+    if (lazyEvaporation) {
+        updatePheromonesLazily();
+        return;
+    }
+
+    runUpdatePhases(
+        [this](int beginRow, int endRow) { evaporatePheromones(beginRow, endRow); },
+        [this](int beginRow, int endRow) { depositPheromones(beginRow, endRow); },
+        [this](int beginRow, int endRow) {
+            if (!compactStorage) {
+                computeChoiceInfo(beginRow, endRow);
+            }
+        });
+
+    // Строка треугольника читает столбец из строк других потоков,
+    // поэтому компактный кэш пересчитывается после обновления всех строк
+    if (compactStorage) {
+        measurePhase(statistics.choiceInfoSeconds, [this]() {
+            forEachRowBlock([this](int beginRow, int endRow) { computeChoiceInfo(beginRow, endRow); });
+        });
+    }
+}
+
+template <typename Evaporate, typename Deposit, typename Refresh>
+void AntColony::runUpdatePhases(Evaporate evaporate, Deposit deposit, Refresh refresh) {
+    // Этапы идут в одном проходе по блоку строк, пока строки в кэше процессора.
+    // Для замера времени этапы выполняются отдельными проходами; порядок операций
+    // над каждой ячейкой тот же, поэтому результат не меняется.
+    if (!statisticsEnabled) {
+        forEachRowBlock([&](int beginRow, int endRow) {
+            evaporate(beginRow, endRow);
+            deposit(beginRow, endRow);
+            refresh(beginRow, endRow);
+        });
+        return;
+    }
+
+    measurePhase(statistics.evaporationSeconds, [&]() { forEachRowBlock(evaporate); });
+    measurePhase(statistics.depositSeconds, [&]() { forEachRowBlock(deposit); });
+    measurePhase(statistics.choiceInfoSeconds, [&]() { forEachRowBlock(refresh); });
+}
+
+void AntColony::updatePheromonesLazily() {
+    // Испарение всех рёбер - умножение общего множителя. Хранимые значения растут
+    // как 1 / S, поэтому перед переполнением они приводятся к истинным значениям.
+    // Это же нужно при снижении нижней границы: при чтении применяется только текущая
+    // граница, а при её росте max(τmin, τ * S) совпадает с поитерационным испарением.
+    double scale = pheromoneScale * (1.0 - rho);
+    double limit = compactStorage ? LazyScaleLimitFloat : LazyScaleLimitDouble;
+    bool renormalize = std::min(scale, std::pow(scale, alpha)) < limit || pheromoneMin < storedPheromoneMin;
+    double floor = std::max(pheromoneMin, (1.0 - rho) * storedPheromoneMin);
+
+    pheromoneScale = renormalize ? 1.0 : scale;
+    storedPheromoneMin = pheromoneMin;
+    updateLazyFloorWeight();
+
+    // Без приведения обновляются только веса рёбер, на которые отложен феромон
+    runUpdatePhases(
+        [this, renormalize, scale, floor](int beginRow, int endRow) {
+            if (renormalize) {
+                renormalizePheromones(beginRow, endRow, scale, floor);
+            }
+        },
+        [this](int beginRow, int endRow) { depositPheromones(beginRow, endRow); },
+        [this, renormalize](int beginRow, int endRow) {
+            if (!renormalize) {
+                refreshDepositedWeights(beginRow, endRow);
+            } else if (!compactStorage) {
+                computeChoiceInfo(beginRow, endRow);
+            }
+        });
+
+    if (renormalize && compactStorage) {
+        measurePhase(statistics.choiceInfoSeconds, [this]() {
+            forEachRowBlock([this](int beginRow, int endRow) { computeChoiceInfo(beginRow, endRow); });
+        });
+    }
+}
+
+void AntColony::prepareDeposits() {
+    deposits.clear();
+
+    switch (variant) {
+    case AcoVariant::AntSystem:
+    case AcoVariant::ElitistAntSystem:
+        // Все муравьи; в элитной системе ещё и лучший маршрут с весом e
+        for (const Ant& ant : ants) {
+            deposits.emplace_back(ant.successor.data(), Q / ant.totalCost);
+        }
+        if (variant == AcoVariant::ElitistAntSystem) {
+            deposits.emplace_back(bestSuccessor.data(), variantParameters.elitistWeight * Q / bestCost);
+        }
+        break;
+
+    case AcoVariant::RankBasedAntSystem: {
+        // w - 1 лучших муравьёв итерации с весами w - r и лучший маршрут с весом w
+        antOrder.resize(numAnts);
+        for (int i = 0; i < numAnts; ++i) {
+            antOrder[i] = i;
+        }
+        std::sort(antOrder.begin(), antOrder.end(), [this](int a, int b) {
+            return ants[a].totalCost < ants[b].totalCost;
+        });
+
+        int ranks = std::max(1, variantParameters.rankedAnts);
+        for (int r = 0; r < std::min(ranks - 1, numAnts); ++r) {
+            const Ant& ant = ants[antOrder[r]];
+            deposits.emplace_back(ant.successor.data(), (ranks - 1 - r) * Q / ant.totalCost);
+        }
+        deposits.emplace_back(bestSuccessor.data(), ranks * Q / bestCost);
+        break;
+    }
+
+    case AcoVariant::MaxMinAntSystem: {
+        // Один маршрут: лучший найденный или лучший в итерации
+        if (variantParameters.mmasGlobalBest) {
+            deposits.emplace_back(bestSuccessor.data(), Q / bestCost);
+        } else {
+            auto iterationBest = std::min_element(ants.begin(), ants.end(), [](const Ant& a, const Ant& b) {
+                return a.totalCost < b.totalCost;
+            });
+            deposits.emplace_back(iterationBest->successor.data(), Q / iterationBest->totalCost);
+        }
+        break;
+    }
+
+    case AcoVariant::AntColonySystem:
+        break;
+    }
+}
+
+void AntColony::updatePheromoneBounds() {
+    if (variant != AcoVariant::MaxMinAntSystem) {
+        return;
+    }
+
+    // τmax = Q / (ρ * L_best); τmin выбирается так, чтобы при сходимости
+    // лучший маршрут строился с вероятностью pBest
+    pheromoneMax = Q / (rho * bestCost);
+    double pDecision = std::pow(variantParameters.mmasPBest, 1.0 / numVertices);
+    double averageChoices = std::max(2.0, numVertices / 2.0);
+    pheromoneMin = std::min(pheromoneMax, pheromoneMax * (1.0 - pDecision) / ((averageChoices - 1.0) * pDecision));
+
+    // Первая итерация и застой: феромон переинициализируется верхней границей
+    bool stagnated = variantParameters.mmasRestartIterations > 0 &&
+                     iterationsSinceImprovement >= variantParameters.mmasRestartIterations;
+    if (currentIteration == 0 || stagnated) {
+        initializeTrails(pheromoneMax);
+        iterationsSinceImprovement = 0;
+    }
+}
+
+template <typename Trails>
+void AntColony::updateEdge(Trails& trails, int from, int to, double pheromone) {
+    auto& stored = trails.pheromones(from, to);
+    stored = static_cast<std::decay_t<decltype(stored)>>(pheromone);
+
+    if (!trails.choiceInfo.empty()) {
+        updateChoiceWeight(trails, from, to, std::pow(stored, alpha) * trails.heuristicPowers(from, to));
+
+        // В треугольнике то же значение τ относится и к обратному ребру
+        if (std::decay_t<decltype(trails.pheromones)>::Symmetric) {
+            updateChoiceWeight(trails, to, from, std::pow(stored, alpha) * trails.heuristicPowers(to, from));
+        }
+    }
+}
+
+template <typename Trails>
+void AntColony::updateChoiceWeight(Trails& trails, int from, int to, double weight) {
+    using Weight = typename decltype(trails.choiceInfo)::value_type;
+
+    Weight& stored = trails.choiceInfo(from, to);
+    Weight delta = static_cast<Weight>(weight) - stored;
+    stored = static_cast<Weight>(weight);
+
+    // Дерево строки меняется на разницу весов за O(log N)
+    if (!trails.samplingTrees.empty()) {
+        FenwickTree<Weight>(trails.samplingTrees.row(from), numVertices).add(to, delta);
+    }
+}
+
+void AntColony::localPheromoneUpdate(int from, int to) {
+    // τ = (1 - ξ) * τ + ξ * τ0
+    withTrails([&](auto& trails) {
+        double pheromone = trails.pheromones(from, to);
+        updateEdge(trails, from, to, (1.0 - variantParameters.acsXi) * pheromone + variantParameters.acsXi * initialPheromone);
+    });
+}
+
+void AntColony::globalPheromoneUpdate() {
+    // τ = (1 - ρ) * τ + ρ * Q / L_best только на рёбрах лучшего маршрута
+    double deltaPheromone = Q / bestCost;
+
+    withTrails([&](auto& trails) {
+        for (int from = 0; from < numVertices; ++from) {
+            int to = bestSuccessor[from];
+            if (from == to) {
+                continue;
+            }
+
+            double pheromone = trails.pheromones(from, to);
+            updateEdge(trails, from, to, (1.0 - rho) * pheromone + rho * deltaPheromone);
+        }
+    });
+}
+
+void AntColony::evaporatePheromones(int beginRow, int endRow) {
+    withTrails([&](auto& trails) {
+        using Scalar = typename decltype(trails.pheromones)::value_type;
+        const Scalar decay = static_cast<Scalar>(1.0 - rho);
+        const Scalar floor = static_cast<Scalar>(pheromoneMin);
+
+        for (int i = beginRow; i < endRow; ++i) {
+            int length;
+            Scalar* pheromoneRow = storedRow(trails.pheromones, i, length);
+
+            for (int j = 0; j < length; ++j) {
+                pheromoneRow[j] *= decay;
+
+                // Минимальный уровень феромона
+                if (pheromoneRow[j] < floor) {
+                    pheromoneRow[j] = floor;
+                }
+            }
+        }
+    });
+}
+
+void AntColony::renormalizePheromones(int beginRow, int endRow, double scale, double floor) {
+    withTrails([&](auto& trails) {
+        using Scalar = typename decltype(trails.pheromones)::value_type;
+
+        for (int i = beginRow; i < endRow; ++i) {
+            int length;
+            Scalar* pheromoneRow = storedRow(trails.pheromones, i, length);
+
+            for (int j = 0; j < length; ++j) {
+                pheromoneRow[j] = static_cast<Scalar>(std::max(floor, pheromoneRow[j] * scale));
+            }
+        }
+    });
+}
+
+void AntColony::depositPheromones(int beginRow, int endRow) {
+    withTrails([&](auto& trails) {
+        for (const auto& deposit : deposits) {
+            depositRoute(trails.pheromones, deposit.first, deposit.second, pheromoneMin, pheromoneMax,
+                         pheromoneScale, beginRow, endRow);
+        }
+    });
+}
+
+void AntColony::refreshDepositedWeights(int beginRow, int endRow) {
+    withTrails([&](auto& trails) {
+        if (trails.choiceInfo.empty()) {
+            return;
+        }
+
+        for (const auto& deposit : deposits) {
+            forEachRouteEdge(trails.pheromones, deposit.first, numVertices, beginRow, endRow, [&](int from, int to) {
+                double weight = std::pow(trails.pheromones(from, to), alpha);
+                updateChoiceWeight(trails, from, to, weight * trails.heuristicPowers(from, to));
+
+                if (std::decay_t<decltype(trails.pheromones)>::Symmetric) {
+                    updateChoiceWeight(trails, to, from, weight * trails.heuristicPowers(to, from));
+                }
+            });
+        }
+    });
+}
+
+double AntColony::nearestNeighbourCost() const {
+    // Жадный маршрут от вершины 0: ближайший непосещённый кандидат, иначе полный перебор
+    std::vector<bool> visited(numVertices, false);
+    int current = 0;
+    visited[current] = true;
+    double cost = 0.0;
+
+    for (int step = 1; step < numVertices; ++step) {
+        int next = -1;
+
+        for (int c = 0; c < numCandidates; ++c) {
+            int vertex = getCandidates(current)[c];
+            if (!visited[vertex]) {
+                next = vertex;
+                break;
+            }
+        }
+        if (next < 0) {
+            for (int vertex = 0; vertex < numVertices; ++vertex) {
+                if (!visited[vertex] && (next < 0 || getDistance(current, vertex) < getDistance(current, next))) {
+                    next = vertex;
+                }
+            }
+        }
+
+        cost += getDistance(current, next) + vertices[next].visitCost;
+        visited[next] = true;
+        current = next;
+    }
+
+    cost += getDistance(current, 0);
+    return std::max(cost, 1e-9);
+}
+
+double AntColony::calculateDistance(int v1, int v2) const {
+    return metricDistance(metric, vertices[v1].position, vertices[v2].position);
+}
+
+double AntColony::getPheromone(int from, int to) const {
+    if (from != to) {
+        double stored = withTrails([from, to](const auto& trails) { return static_cast<double>(trails.pheromones(from, to)); });
+        return lazyEvaporation ? std::max(pheromoneMin, stored * pheromoneScale) : stored;
+    }
+    return 0.0;
+}
+
+void AntColony::collectConvergenceStatistics() {
+    // Стоимости маршрутов муравьёв итерации
+    double sum = 0.0;
+    statistics.minCost = std::numeric_limits<double>::max();
+    statistics.maxCost = 0.0;
+    for (const Ant& ant : ants) {
+        sum += ant.totalCost;
+        statistics.minCost = std::min(statistics.minCost, ant.totalCost);
+        statistics.maxCost = std::max(statistics.maxCost, ant.totalCost);
+    }
+    statistics.meanCost = numAnts > 0 ? sum / numAnts : 0.0;
+    statistics.bestCost = bestCost;
+
+    measureConvergence(statistics.branchingFactor, statistics.entropy);
+}
+
+void AntColony::measureConvergence(double& branchingFactor, double& entropy) const {
+    branchingFactor = 0.0;
+    entropy = 0.0;
+
+    // Списки кандидатов или соседей локального поиска, без них - все вершины строки
+    const int* lists = numCandidates > 0 ? candidates.data()
+                     : numLocalSearchNeighbours > 0 ? localSearchNeighbours.data()
+                     : nullptr;
+    int k = numCandidates > 0 ? numCandidates : lists ? numLocalSearchNeighbours : numVertices - 1;
+    if (k < 1) {
+        return;
+    }
+
+    for (int i = 0; i < numVertices; ++i) {
+        const int* list = lists ? lists + static_cast<size_t>(i) * k : nullptr;
+        auto neighbour = [list, i](int n) { return list ? list[n] : (n < i ? n : n + 1); };
+
+        double low = std::numeric_limits<double>::max();
+        double high = 0.0;
+        double total = 0.0;
+        for (int n = 0; n < k; ++n) {
+            double pheromone = getPheromone(i, neighbour(n));
+            low = std::min(low, pheromone);
+            high = std::max(high, pheromone);
+            total += pheromone;
+        }
+
+        double threshold = low + BranchingLambda * (high - low);
+        int count = 0;
+        double h = 0.0;
+        for (int n = 0; n < k; ++n) {
+            double pheromone = getPheromone(i, neighbour(n));
+            if (pheromone >= threshold) {
+                ++count;
+            }
+            if (pheromone > 0.0) {
+                double p = pheromone / total;
+                h -= p * std::log(p);
+            }
+        }
+
+        branchingFactor += count;
+        entropy += k > 1 ? h / std::log(static_cast<double>(k)) : 0.0;
+    }
+
+    branchingFactor /= numVertices;
+    entropy /= numVertices;
+}
+
+double AntColony::measureDiversity() const {
+    // Доля рёбер маршрутов муравьёв, которых нет в лучшем маршруте итерации
+    // (в симметричной задаче ребро совпадает и в обратном направлении)
+    auto best = std::min_element(ants.begin(), ants.end(), [](const Ant& a, const Ant& b) {
+        return a.totalCost < b.totalCost;
+    });
+    if (best == ants.end() || numVertices < 2) {
+        return 0.0;
+    }
+
+    const std::vector<int>& reference = best->successor;
+    long long differing = 0;
+    for (const Ant& ant : ants) {
+        for (int i = 0; i < numVertices; ++i) {
+            int j = ant.successor[i];
+            if (reference[i] != j && !(symmetricDistances && reference[j] == i)) {
+                ++differing;
+            }
+        }
+    }
+    return static_cast<double>(differing) / (static_cast<double>(numAnts) * numVertices);
+}
+
+double AntColony::calculateRouteCost(const std::vector<int>& route) {
+    double cost = 0.0;
+
+    for (size_t i = 0; i < route.size(); ++i) {
+        int from = route[i];
+        int to = route[(i + 1) % route.size()];
+
+        cost += getDistance(from, to);
+        cost += vertices[to].visitCost;
+    }
+
+    return cost;
+}
@@ -0,0 +1,614 @@
+#ifndef ANTCOLONY_H
+#define ANTCOLONY_H
+
+#include <vector>
+#include <random>
+#include <chrono>
+#include <functional>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include "instance.h"
+#include "choicekernel.h"
+#include "distancematrix.h"
+#include "fenwicktree.h"
+#include "localsearch.h"
+#include "matrix.h"
+#include "termination.h"
+#include "threadpool.h"
+
+// Структура ребра графа
+struct Edge {
+    int from;               // Начальная вершина
+    int to;                 // Конечная вершина
+    double distance;        // Расстояние между вершинами
+    double pheromone;       // Уровень феромона на ребре
+
+    Edge(int f, int t, double dist)
+        : from(f), to(t), distance(dist), pheromone(1.0) {}
+
+    Edge(int f, int t, double dist, double pher)
+        : from(f), to(t), distance(dist), pheromone(pher) {}
+};
+
+class AntColony;
+
+// Представление рёбер полного графа поверх матриц расстояний и феромонов колонии.
+// Рёбра не хранятся отдельно, а собираются при обходе (i -> j, i != j).
+class EdgeView {
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Edge;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Edge;
+
+        const_iterator(const EdgeView* view, int from, int to)
+            : view(view), from(from), to(to) { skipDiagonal(); }
+
+        inline Edge operator*() const;
+
+        const_iterator& operator++() {
+            advance();
+            skipDiagonal();
+            return *this;
+        }
+
+        bool operator==(const const_iterator& other) const { return from == other.from && to == other.to; }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+    private:
+        void advance() {
+            if (++to >= view->numVertices) {
+                to = 0;
+                ++from;
+            }
+        }
+
+        void skipDiagonal() {
+            if (from < view->numVertices && from == to) {
+                advance();
+            }
+        }
+
+        const EdgeView* view;
+        int from;
+        int to;
+    };
+
+    EdgeView(const AntColony* colony, int numVertices)
+        : colony(colony), numVertices(numVertices) {}
+
+    const_iterator begin() const { return const_iterator(this, 0, numVertices > 1 ? 0 : numVertices); }
+    const_iterator end() const { return const_iterator(this, numVertices, 0); }
+    std::size_t size() const { return numVertices > 1 ? static_cast<std::size_t>(numVertices) * (numVertices - 1) : 0; }
+    bool empty() const { return size() == 0; }
+
+private:
+    const AntColony* colony;
+    int numVertices;
+};
+
+// Класс для представления муравья. Вся память под маршрут и рабочие массивы
+// выделяется при создании, построение маршрута память не выделяет.
+class Ant {
+public:
+    std::vector<int> route;           // Маршрут муравья
+    std::vector<char> visited;        // Посещённые вершины (байтовая маска для векторных ядер)
+    std::vector<int> successor;       // Следующая вершина маршрута для каждой вершины
+    std::vector<int> unvisited;       // Непосещённые вершины в произвольном порядке
+    std::vector<int> unvisitedIndex;  // Позиция вершины в unvisited
+    double totalCost;                 // Общая стоимость маршрута
+    int currentVertex;                // Текущая вершина
+
+    Ant(int numVertices)
+        : visited(numVertices, 0), successor(numVertices, -1), unvisitedIndex(numVertices, -1),
+          totalCost(0.0), currentVertex(-1) {
+        route.reserve(numVertices);
+        unvisited.reserve(numVertices);
+    }
+
+    // Копия получает ту же зарезервированную память, что и оригинал
+    Ant(const Ant& other) : Ant(static_cast<int>(other.visited.size())) {
+        *this = other;
+    }
+
+    Ant& operator=(const Ant&) = default;
+
+    void reset(int startVertex) {
+        int numVertices = static_cast<int>(visited.size());
+
+        // После обмена с лучшим маршрутом у route может не оказаться резерва
+        route.clear();
+        route.reserve(numVertices);
+        std::fill(visited.begin(), visited.end(), 0);
+        unvisited.resize(numVertices);
+        for (int i = 0; i < numVertices; ++i) {
+            unvisited[i] = i;
+            unvisitedIndex[i] = i;
+        }
+
+        totalCost = 0.0;
+        visit(startVertex);
+    }
+
+    // Переход в вершину: добавление в маршрут и удаление из непосещённых за O(1)
+    // (на место вершины в unvisited ставится последняя)
+    void visit(int vertex) {
+        currentVertex = vertex;
+        route.push_back(vertex);
+        visited[vertex] = 1;
+
+        int position = unvisitedIndex[vertex];
+        int last = unvisited.back();
+        unvisited[position] = last;
+        unvisitedIndex[last] = position;
+        unvisited.pop_back();
+    }
+
+    // Рабочий буфер весов строки: double в полном режиме, float в компактном.
+    // Выделяется при первом выборе вершины и дальше переиспользуется.
+    template <typename T>
+    T* weightBuffer() {
+        std::vector<T>& buffer = weightStorage(static_cast<T*>(nullptr));
+        if (buffer.size() != visited.size()) {
+            buffer.resize(visited.size());
+        }
+        return buffer.data();
+    }
+
+    // Заполнение successor по готовому замкнутому маршруту
+    void linkRoute() {
+        for (size_t i = 0; i < route.size(); ++i) {
+            successor[route[i]] = route[(i + 1) % route.size()];
+        }
+    }
+
+private:
+    std::vector<double>& weightStorage(double*) { return weights; }
+    std::vector<float>& weightStorage(float*) { return compactWeights; }
+
+    std::vector<double> weights;
+    std::vector<float> compactWeights;
+};
+
+// Вариант муравьиного алгоритма: правило выбора вершины и обновления феромонов
+enum class AcoVariant {
+    AntSystem,          // Все муравьи откладывают Q / L
+    ElitistAntSystem,   // AS + дополнительный вклад лучшего найденного маршрута
+    RankBasedAntSystem, // Откладывают лучшие муравьи итерации с весами по рангу и лучший маршрут
+    MaxMinAntSystem,    // Откладывает один маршрут, феромон ограничен [τmin, τmax]
+    AntColonySystem     // Псевдослучайное правило выбора, локальное и глобальное обновление
+};
+
+// Параметры вариантов (каждый вариант использует только свои поля)
+struct VariantParameters {
+    double elitistWeight = 5.0;       // Elitist: вес лучшего маршрута (e)
+    int rankedAnts = 6;               // Rank-based: количество рангов (w)
+    bool mmasGlobalBest = false;      // MMAS: откладывает лучший найденный маршрут, иначе лучший маршрут итерации
+    double mmasPBest = 0.05;          // MMAS: вероятность построить лучший маршрут при сходимости (определяет τmin)
+    int mmasRestartIterations = 100;  // MMAS: итераций без улучшения до переинициализации (0 - без неё)
+    double acsQ0 = 0.9;               // ACS: вероятность выбора лучшего ребра
+    double acsXi = 0.1;               // ACS: коэффициент локального обновления
+};
+
+// Перезапуск при застое: каждые checkInterval итераций проверяется сходимость,
+// и если колония сошлась, феромон переинициализируется (лучший маршрут сохраняется).
+// Пороги 0 отключают соответствующую проверку.
+struct RestartParameters {
+    double minBranching = 0.0;  // Застой, если среднее λ-ветвление ниже (при сходимости MMAS - около 2)
+    double minDiversity = 0.0;  // Застой, если доля рёбер муравьёв вне лучшего маршрута итерации ниже
+    int checkInterval = 10;     // Период проверки в итерациях
+};
+
+// Статистика итерации (сбор включается setStatisticsEnabled). Время этапов -
+// стенное время в секундах; параллельные этапы измеряются целиком.
+struct IterationStatistics {
+    int iteration = 0;                 // Номер итерации (с 1)
+    double iterationSeconds = 0.0;     // Вся итерация без вызова обработчиков
+    double constructionSeconds = 0.0;  // Построение маршрутов без локального поиска
+    double localSearchSeconds = 0.0;   // Локальный поиск (для всех муравьёв - наибольшее время потока)
+    double evaporationSeconds = 0.0;   // Испарение (при ленивом - только приведение к истинным значениям)
+    double depositSeconds = 0.0;       // Откладывание феромона (ACS - глобальное обновление)
+    double choiceInfoSeconds = 0.0;    // Пересчёт весов выбора
+    double stepsPerSecond = 0.0;       // Переходов муравьёв в секунду построения
+    long long allocations = -1;        // Выделений памяти за итерацию (-1 - счётчик не задан)
+
+    // Сходимость
+    double branchingFactor = 0.0;      // Среднее λ-ветвление (λ = 0.05) по спискам соседей
+    double entropy = 0.0;              // Средняя энтропия феромона строк, нормированная к [0, 1]
+    double meanCost = 0.0;             // Стоимости маршрутов муравьёв итерации
+    double minCost = 0.0;
+    double maxCost = 0.0;
+    double bestCost = 0.0;             // Лучшая найденная стоимость
+};
+
+// Способ хранения матриц колонии
+enum class StorageMode {
+    Dense,      // Полные матрицы N x N в double
+    Compact     // Для симметричных задач: верхний треугольник расстояний (int32 для
+                // целочисленных метрик, иначе float) и феромонов (float), веса выбора в float
+};
+
+// Выбор вершины рулеткой при полном переборе (без списков кандидатов)
+enum class SamplingMode {
+    Normalized, // Веса делятся на сумму, случайное число из [0, 1)
+    Scaled,     // Случайное число из [0, сумма): без деления весов
+    Tree        // Деревья Фенвика по строкам choiceInfo, общие для всех муравьёв:
+                // выбор за O(log N), посещённая вершина отбрасывается и выбор повторяется
+};
+
+// Феромоны и веса выбора. Pheromones - Matrix<T> или SymmetricMatrix<T>,
+// Weight - тип элементов строк, по которым муравьи выбирают вершину.
+template <typename Pheromones, typename Weight>
+struct TrailMatrices {
+    Pheromones pheromones;           // τ
+    Matrix<Weight> heuristics;       // η = 1 / (расстояние + стоимость посещения), только в полном режиме
+    Matrix<Weight> heuristicPowers;  // η^β (вычисляется один раз при построении графа)
+    Matrix<Weight> choiceInfo;       // τ^α * η^β (обновляется раз в итерацию)
+    Matrix<Weight> samplingTrees;    // Деревья Фенвика по строкам choiceInfo (SamplingMode::Tree)
+};
+
+using DenseTrails = TrailMatrices<Matrix<double>, double>;
+using CompactTrails = TrailMatrices<SymmetricMatrix<float>, float>;
+
+// Основной класс алгоритма муравьиной колонии
+class AntColony {
+    // Бенчмарк замеряет приватные этапы алгоритма по отдельности
+    friend class AntColonyBenchmark;
+
+public:
+    // Конструктор
+    AntColony(int numVertices, int numAnts, double alpha, double beta,
+              double rho, double Q, int maxIterations);
+
+    // Генерация случайного графа
+    void generateRandomGraph(int width, int height);
+
+    // Задание графа по готовому списку вершин (евклидова метрика)
+    void setGraph(const std::vector<Vertex>& graphVertices);
+
+    // Задание графа по загруженной задаче (метрика и матрица расстояний TSPLIB)
+    void setInstance(const Instance& instance);
+
+    // Запуск одной итерации алгоритма
+    void runIteration();
+
+    // Запуск итераций до достижения maxIterations
+    void run();
+
+    // Сброс алгоритма
+    void reset();
+
+    // Приём маршрута другой колонии (островная модель): маршрут откладывает
+    // феромон Q / L как муравей (кроме ACS) и заменяет лучший, если он короче.
+    // Возвращает true, если лучший маршрут улучшился.
+    bool importRoute(const std::vector<int>& route);
+
+    // Смешивание феромонов с матрицей target: τ = (1 - weight) * τ + weight * target
+    // (в истинных значениях, с учётом границ варианта)
+    void blendPheromones(const Matrix<double>& target, double weight);
+
+    // Изменение задачи между итерациями без перестроения графа. Пересчитываются только
+    // строка и столбец вершины в матрицах расстояний и эвристики и затронутые списки
+    // соседей. Феромоны сохраняются: рёбра новой или перемещённой вершины получают
+    // феромоны её ближайшего соседа, а все уровни (и границы MMAS, τ0 ACS) умножаются
+    // на L_old / L_new. Лучший маршрут исправляется вставкой вершины в самое дешёвое
+    // место и локальным поиском, если он включён. При обычном испарении веса выбора
+    // пересчитываются одним проходом по матрице, при ленивом - только строка и столбец.
+    // Добавление и перемещение требуют координат (не EXPLICIT); при неверной вершине
+    // или неподходящей задаче возвращается -1 / false.
+    int addVertex(const Point& position, double visitCost);   // Индекс новой вершины (N - 1)
+    bool removeVertex(int vertex);                             // Последняя вершина получает индекс vertex
+    bool moveVertex(int vertex, const Point& position);
+    bool setVisitCost(int vertex, double visitCost);
+
+    // Изменение лимита итераций (например, для доводки после изменения задачи);
+    // лимит больше текущей итерации возобновляет колонию, остановленную по лимиту
+    void setMaxIterations(int iterations);
+
+    // Количество потоков для построения маршрутов (1 - последовательно)
+    void setThreadCount(int threads);
+    int getThreadCount() const { return numThreads; }
+
+    // Фиксированное зерно генераторов случайных чисел (для воспроизводимости)
+    void setSeed(unsigned int seed);
+
+    // Контрольная точка (формат - CheckpointHeader и секции): граф, параметры,
+    // феромоны, лучший маршрут, счётчики и состояния генераторов. Буфер image
+    // переиспользуется. restoreState заменяет граф и параметры колонии; состояния
+    // генераторов потоков восстанавливаются при том же количестве потоков.
+    void saveState(std::vector<char>& image) const;
+    bool restoreState(const char* data, std::size_t size, std::string& error);
+
+    // Геттеры
+    const std::vector<Vertex>& getVertices() const { return vertices; }
+    EdgeView getEdges() const { return EdgeView(this, numVertices); }
+    const std::vector<int>& getBestRoute() const { return bestRoute; }
+    double getBestCost() const { return bestCost; }
+    int getCurrentIteration() const { return currentIteration; }
+    int getMaxIterations() const { return maxIterations; }
+    int getNumVertices() const { return numVertices; }
+    int getNumAnts() const { return numAnts; }
+    double getAlpha() const { return alpha; }
+    double getBeta() const { return beta; }
+    double getRho() const { return rho; }
+    double getQ() const { return Q; }
+    DistanceMetric getMetric() const { return metric; }
+    bool isFinished() const { return currentIteration >= maxIterations || termination.getReason() != TerminationReason::None; }
+    const std::vector<Ant>& getAnts() const { return ants; }
+
+    // Получение матрицы феромонов (для визуализации)
+    double getPheromone(int from, int to) const;
+    double getDistance(int v1, int v2) const { return distances(v1, v2); }
+
+    // Способ хранения матриц; применяется при следующем задании графа.
+    // Компактный режим для несимметричной задачи заменяется полным.
+    void setStorageMode(StorageMode mode) { storageMode = mode; }
+    StorageMode getStorageMode() const { return storageMode; }
+    bool isCompactStorage() const { return compactStorage; }
+    const DistanceMatrix& getDistances() const { return distances; }
+
+    // Объём матриц N x N в байтах
+    std::size_t getMatrixBytes() const;
+
+    // Кэш τ^α * η^β (choice info); отключение нужно для сравнения производительности
+    void setUseChoiceInfo(bool enabled);
+    bool isChoiceInfoEnabled() const { return useChoiceInfo; }
+
+    // Ленивое испарение: феромон хранится в единицах общего множителя S, и испарение
+    // всех рёбер - это S *= (1 - ρ). Истинное значение max(τmin, τ * S) вычисляется
+    // при чтении, а обновление за итерацию затрагивает только рёбра маршрутов.
+    // Выбор по деревьям Фенвика в этом режиме не используется.
+    void setLazyEvaporation(bool enabled);
+    bool isLazyEvaporation() const { return lazyEvaporation; }
+
+    // Способ выбора вершины рулеткой при полном переборе. Деревья строятся
+    // только при включённом choiceInfo и без списков кандидатов.
+    void setSamplingMode(SamplingMode mode);
+    SamplingMode getSamplingMode() const { return samplingMode; }
+
+    // Набор инструкций векторных ядер весов (неподдерживаемый заменяется скалярным)
+    void setSimdIsa(SimdIsa isa);
+    SimdIsa getSimdIsa() const { return simdIsa; }
+
+    // Списки кандидатов: k ближайших вершин для каждой вершины (0 - полный перебор)
+    void setCandidateListSize(int k);
+    int getCandidateListSize() const { return numCandidates; }
+    const int* getCandidates(int vertex) const { return candidates.data() + static_cast<size_t>(vertex) * numCandidates; }
+
+    // Вариант алгоритма и его параметры
+    void setVariant(AcoVariant variant, const VariantParameters& parameters = VariantParameters());
+    AcoVariant getVariant() const { return variant; }
+    const VariantParameters& getVariantParameters() const { return variantParameters; }
+
+    // Локальный поиск после построения маршрутов (moves - комбинация LocalSearchMove)
+    void setLocalSearch(LocalSearchMode mode, int moves = LocalSearchTwoOpt | LocalSearchOrOpt);
+    LocalSearchMode getLocalSearchMode() const { return localSearchMode; }
+    int getLocalSearchMoves() const { return localSearchMoves; }
+
+    // Досрочное завершение: лимит времени, целевая стоимость, отсутствие улучшений.
+    // После завершения лучший найденный маршрут остаётся доступен; сброс снимает завершение.
+    void setTermination(const TerminationCriteria& criteria) { termination.setCriteria(criteria); }
+    const TerminationCriteria& getTermination() const { return termination.getCriteria(); }
+    TerminationReason getTerminationReason() const;
+    double getElapsedSeconds() const { return termination.getElapsedSeconds(); }
+
+    // Перезапуск феромона при застое (RestartParameters)
+    void setRestart(const RestartParameters& parameters) { restartParameters = parameters; }
+    const RestartParameters& getRestart() const { return restartParameters; }
+    int getRestartCount() const { return restartCount; }
+
+    // Показатели сходимости по спискам соседей (без них - по всем рёбрам): среднее
+    // λ-ветвление и нормированная энтропия феромона; разнообразие маршрутов итерации
+    void measureConvergence(double& branchingFactor, double& entropy) const;
+    double measureDiversity() const;
+
+    // Статистика итераций (IterationStatistics). Выключенный сбор стоит одной проверки
+    // на этап; включённый выполняет обновление феромонов отдельными проходами по этапам
+    // и после итерации обходит списки соседей (без них - все рёбра) для показателей сходимости.
+    void setStatisticsEnabled(bool enabled) { statisticsEnabled = enabled; }
+    bool isStatisticsEnabled() const { return statisticsEnabled; }
+    const IterationStatistics& getLastStatistics() const { return lastStatistics; }
+
+    // Накопленное приложением количество выделений памяти (для поля allocations)
+    void setAllocationCounter(std::function<std::size_t()> counter) { allocationCounter = std::move(counter); }
+
+    // Обработчики событий алгоритма
+    void setIterationCallback(std::function<void(int iteration, double bestCost)> callback) { iterationCompleted = std::move(callback); }
+    void setFinishedCallback(std::function<void()> callback) { algorithmFinished = std::move(callback); }
+    void setStatisticsCallback(std::function<void(const IterationStatistics&)> callback) { statisticsCollected = std::move(callback); }
+
+private:
+    // Параметры алгоритма
+    int numVertices;          // Количество вершин
+    int numAnts;              // Количество муравьёв
+    double alpha;             // Влияние феромона
+    double beta;              // Влияние эвристической информации
+    double rho;               // Коэффициент испарения феромона
+    double Q;                 // Константа для обновления феромона
+    int maxIterations;        // Максимальное количество итераций
+    int currentIteration;     // Текущая итерация
+
+    // Структуры данных графа
+    std::vector<Vertex> vertices;      // Вершины графа
+    DistanceMetric metric;             // Функция расстояния
+    DistanceMatrix distances;          // Матрица расстояний
+    StorageMode storageMode;           // Запрошенный способ хранения
+    bool compactStorage;               // Матрицы графа хранятся в компактном виде
+    DenseTrails denseTrails;           // Феромоны и веса (полный режим)
+    CompactTrails compactTrails;       // Феромоны и веса (компактный режим)
+    bool useChoiceInfo;                // Использовать ли кэш choiceInfo
+    int candidateListSize;             // Запрошенный размер списка кандидатов (k)
+    int numCandidates;                 // Фактический размер списка (не больше numVertices - 1)
+    std::vector<int> candidates;       // Списки кандидатов, numVertices x k построчно
+    bool symmetricDistances;           // d(i, j) == d(j, i) для всех пар
+    SimdIsa simdIsa;                   // Набор инструкций для ядер весов
+    SamplingMode samplingMode;         // Способ выбора рулеткой
+    bool lazyEvaporation;              // Испарение через общий множитель
+    double pheromoneScale;             // Общий множитель S хранимых феромонов (1 без ленивого испарения)
+    double lazyFloorWeight;            // (τmin / S)^α: вес нижней границы в единицах S^α
+    double storedPheromoneMin;         // Нижняя граница, действовавшая при последнем испарении (0 после инициализации)
+
+    // Локальный поиск
+    LocalSearchMode localSearchMode;
+    int localSearchMoves;
+    int numLocalSearchNeighbours;          // Свои списки соседей, если нет списков кандидатов
+    std::vector<int> localSearchNeighbours;
+    std::vector<LocalSearch> localSearchers;  // Рабочие массивы для каждого потока
+    std::vector<std::pair<double, int>> neighbourBuffer;  // Строка соседей при исправлении списков
+
+    // Вариант алгоритма
+    AcoVariant variant;
+    VariantParameters variantParameters;
+    double pheromoneMin;               // Нижняя граница феромона (τmin для MMAS)
+    double pheromoneMax;               // Верхняя граница феромона (τmax для MMAS)
+    double initialPheromone;           // τ0 для локального обновления ACS
+    int iterationsSinceImprovement;    // Итераций без улучшения лучшего маршрута
+    std::vector<std::pair<const int*, double>> deposits;  // Маршруты (successor) и их вклад в текущей итерации
+    std::vector<int> antOrder;         // Муравьи по возрастанию стоимости (rank-based)
+
+    // Муравьиная колония
+    std::vector<Ant> ants;            // Муравьи
+    std::vector<int> bestRoute;       // Лучший найденный маршрут
+    std::vector<int> bestSuccessor;   // Лучший маршрут в виде successor
+    std::vector<int> importedSuccessor;  // Принятый маршрут в виде successor
+    double bestCost;                  // Стоимость лучшего маршрута
+
+    // Генератор случайных чисел (граф и зёрна потоков)
+    std::mt19937 rng;
+
+    // Параллельное построение: у каждого потока свой блок муравьёв и свой генератор
+    int numThreads;
+    int requestedThreads;             // Заданное количество потоков (numThreads не больше numAnts)
+    std::unique_ptr<ThreadPool> pool;
+    std::vector<std::mt19937> workerRngs;
+
+    // Завершение и перезапуски
+    TerminationMonitor termination;
+    RestartParameters restartParameters;
+    int restartCount;                  // Перезапусков с последнего сброса
+
+    // Статистика итераций
+    bool statisticsEnabled;
+    IterationStatistics statistics;           // Заполняется во время итерации
+    IterationStatistics lastStatistics;       // Последняя завершённая итерация
+    std::vector<double> localSearchSeconds;   // Время локального поиска каждого потока
+    std::function<std::size_t()> allocationCounter;
+
+    // Обработчики событий
+    std::function<void(int, double)> iterationCompleted;
+    std::function<void()> algorithmFinished;
+    std::function<void(const IterationStatistics&)> statisticsCollected;
+
+    // Вспомогательные методы
+    void notifyIterationCompleted();
+    void notifyFinished();
+    void assignVertices(const std::vector<Vertex>& graphVertices);
+    void initializeEdges(const Matrix<double>* explicitDistances = nullptr);
+    bool fillDistances(DistanceMatrix::Storage storage, const Matrix<double>* explicitDistances);
+    void seedWorkers();
+    void constructAntSolutions(int worker, int workers);
+    void constructAntSolution(Ant& ant, std::mt19937& rng);
+    int selectNextVertex(Ant& ant, std::mt19937& rng);
+    void buildCandidateLists();
+    void buildLocalSearchNeighbours();
+    void buildNeighbourLists(int k, std::vector<int>& lists) const;
+    double neighbourDistance(int from, int to) const;
+    void fillNeighbourList(int vertex, int k, int* list);
+    void updateNeighbourLists(int vertex);
+    void removeFromNeighbourLists(int vertex, int last);
+    bool hasExpectedListSizes() const;
+    void resizeGraph(int n);
+    void fillVertexDistances(int vertex);
+    void updateVertexHeuristics(int vertex, bool row);
+    void inheritPheromones(int vertex);
+    void moveLastVertex(int vertex);
+    void detachFromBestRoute(int vertex);
+    void insertIntoBestRoute(int vertex);
+    void finishGraphChange(int vertex, double previousCost);
+    void improveAntSolution(Ant& ant, LocalSearch& search);
+    double calculateRouteCost(const std::vector<int>& route);
+    void updatePheromones();
+    void updatePheromonesLazily();
+    template <typename Evaporate, typename Deposit, typename Refresh>
+    void runUpdatePhases(Evaporate evaporate, Deposit deposit, Refresh refresh);
+    void collectConvergenceStatistics();
+    void restartIfStagnated();
+    void prepareDeposits();
+    void updatePheromoneBounds();
+    void initializeTrails(double value);
+    void localPheromoneUpdate(int from, int to);
+    void globalPheromoneUpdate();
+    double nearestNeighbourCost() const;
+    void evaporatePheromones(int beginRow, int endRow);
+    void renormalizePheromones(int beginRow, int endRow, double scale, double floor);
+    void refreshDepositedWeights(int beginRow, int endRow);
+    void updateLazyFloorWeight();
+    void depositPheromones(int beginRow, int endRow);
+    void computeChoiceInfo();
+    void computeChoiceInfo(int beginRow, int endRow);
+    double calculateDistance(int v1, int v2) const;
+
+    // Реализации для конкретного способа хранения (DenseTrails или CompactTrails)
+    template <typename Trails> void buildHeuristics(Trails& trails);
+    template <typename Trails> void setHeuristic(Trails& trails, int from, int to);
+    template <typename Trails> int selectNextVertex(const Trails& trails, Ant& ant, std::mt19937& rng);
+    template <typename Trails> int sampleFromTree(const Trails& trails, const Ant& ant, std::mt19937& rng) const;
+    template <typename Trails> int selectFromCandidates(const Trails& trails, const Ant& ant, std::mt19937& rng);
+    template <typename Trails> int selectBestCandidate(const Trails& trails, const Ant& ant) const;
+    template <typename Trails> int selectBestNextVertex(const Trails& trails, const Ant& ant) const;
+    template <typename Trails> double choiceWeight(const Trails& trails, int from, int to) const;
+    template <typename Trails> void computeChoiceInfo(Trails& trails, int beginRow, int endRow);
+    template <typename Trails> void updateEdge(Trails& trails, int from, int to, double pheromone);
+    template <typename Trails> void updateChoiceWeight(Trails& trails, int from, int to, double weight);
+
+    // Вызов f(beginRow, endRow) для блоков строк, по блоку на поток
+    template <typename F>
+    void forEachRowBlock(F f) {
+        auto runBlock = [this, &f](int worker) {
+            int beginRow, endRow;
+            ThreadPool::splitRange(numVertices, numThreads, worker, beginRow, endRow);
+            f(beginRow, endRow);
+        };
+
+        if (pool) {
+            pool->run(runBlock);
+        } else {
+            runBlock(0);
+        }
+    }
+
+    // Выполнение этапа f() с добавлением его времени к seconds при включённой статистике
+    template <typename F>
+    void measurePhase(double& seconds, F f) {
+        if (!statisticsEnabled) {
+            f();
+            return;
+        }
+        auto start = std::chrono::steady_clock::now();
+        f();
+        seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Вызов f(trails) для матриц текущего способа хранения
+    template <typename F>
+    decltype(auto) withTrails(F&& f) {
+        return compactStorage ? f(compactTrails) : f(denseTrails);
+    }
+
+    template <typename F>
+    decltype(auto) withTrails(F&& f) const {
+        return compactStorage ? f(compactTrails) : f(denseTrails);
+    }
+};
+
+inline Edge EdgeView::const_iterator::operator*() const {
+    return Edge(from, to, view->colony->getDistance(from, to), view->colony->getPheromone(from, to));
+}
+
+#endif // ANTCOLONY_H
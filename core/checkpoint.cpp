@@ -0,0 +1,139 @@
+#include "checkpoint.h"
+#include "antcolony.h"
+#include "mappedfile.h"
+#include <cstdio>
+
+bool writeCheckpointFile(const std::string& path, const std::vector<char>& image, std::string& error) {
+    std::string temporaryPath = path + ".tmp";
+
+    std::FILE* file = std::fopen(temporaryPath.c_str(), "wb");
+    if (!file) {
+        error = "cannot create " + temporaryPath;
+        return false;
+    }
+
+    bool written = std::fwrite(image.data(), 1, image.size(), file) == image.size();
+    written = std::fclose(file) == 0 && written;
+    if (!written) {
+        error = "cannot write " + temporaryPath;
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+
+#ifdef _WIN32
+    // rename в Windows не заменяет существующий файл
+    std::remove(path.c_str());
+#endif
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        error = "cannot replace " + path;
+        return false;
+    }
+    return true;
+}
+
+bool saveCheckpoint(const std::string& path, const AntColony& colony, std::string& error) {
+    std::vector<char> image;
+    colony.saveState(image);
+    return writeCheckpointFile(path, image, error);
+}
+
+bool loadCheckpoint(const std::string& path, AntColony& colony, std::string& error) {
+    MappedFile file;
+    if (!file.open(path)) {
+        error = "cannot open " + path;
+        return false;
+    }
+    return colony.restoreState(file.data(), file.size(), error);
+}
+
+CheckpointWriter::CheckpointWriter(const std::string& path)
+    : path(path), iterationInterval(100), timeInterval(0), lastIteration(0),
+    lastSave(std::chrono::steady_clock::now()), pending(false), writing(false), stopping(false), saved(0)
+{
+    thread = std::thread(&CheckpointWriter::threadLoop, this);
+}
+
+CheckpointWriter::~CheckpointWriter() {
+    // Снятый образ дописывается до выхода
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    thread.join();
+}
+
+void CheckpointWriter::setInterval(int iterations, int milliseconds) {
+    iterationInterval = std::max(0, iterations);
+    timeInterval = std::max(0, milliseconds);
+}
+
+bool CheckpointWriter::onIteration(const AntColony& colony) {
+    bool byIterations = iterationInterval > 0 &&
+                        colony.getCurrentIteration() - lastIteration >= iterationInterval;
+    bool byTime = timeInterval > 0 &&
+                  std::chrono::steady_clock::now() - lastSave >= std::chrono::milliseconds(timeInterval);
+
+    if (byIterations || byTime) {
+        save(colony);
+        return true;
+    }
+    return false;
+}
+
+void CheckpointWriter::save(const AntColony& colony) {
+    colony.saveState(images.writeBuffer());
+    images.publish();
+    lastIteration = colony.getCurrentIteration();
+    lastSave = std::chrono::steady_clock::now();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = true;
+    }
+    wakeUp.notify_all();
+}
+
+void CheckpointWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this]() { return !pending && !writing; });
+}
+
+int CheckpointWriter::getSavedCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return saved;
+}
+
+std::string CheckpointWriter::getLastError() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return lastError;
+}
+
+void CheckpointWriter::threadLoop() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeUp.wait(lock, [this]() { return pending || stopping; });
+            if (!pending) {
+                return;
+            }
+            pending = false;
+            writing = true;
+        }
+
+        // Файл пишется без блокировки: решатель тем временем снимает следующий образ
+        std::string error;
+        bool written = images.update() && writeCheckpointFile(path, images.readBuffer(), error);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            writing = false;
+            if (written) {
+                ++saved;
+            } else if (!error.empty()) {
+                lastError = error;
+            }
+        }
+        idle.notify_all();
+    }
+}
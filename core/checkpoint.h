@@ -0,0 +1,135 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "triplebuffer.h"
+
+class AntColony;
+
+// Версия формата контрольной точки; файлы другой версии не загружаются
+const std::uint32_t CheckpointVersion = 1;
+
+// Участок файла: смещение от начала файла и размер в байтах
+struct CheckpointSection {
+    std::uint64_t offset;
+    std::uint64_t size;
+};
+
+// Заголовок контрольной точки. Файл - образ памяти: заголовок и за ним секции,
+// выровненные по 64 байтам. При возобновлении файл отображается в память, и
+// массивы копируются в матрицы колонии без разбора. Порядок байтов - родной.
+struct CheckpointHeader {
+    char magic[8];                      // "ACOCKPT"
+    std::uint32_t version;              // CheckpointVersion
+    std::uint32_t headerSize;           // sizeof(CheckpointHeader)
+
+    // Параметры алгоритма
+    std::int32_t numVertices;
+    std::int32_t numAnts;
+    std::int32_t maxIterations;
+    std::int32_t currentIteration;
+    std::int32_t iterationsSinceImprovement;
+    std::int32_t variant;               // AcoVariant
+    std::int32_t metric;                // DistanceMetric
+    std::int32_t storageMode;           // StorageMode
+    std::int32_t compactStorage;        // Феромоны в треугольнике float, иначе N x N double
+    std::int32_t samplingMode;          // SamplingMode
+    std::int32_t lazyEvaporation;
+    std::int32_t candidateListSize;
+    std::int32_t localSearchMode;       // LocalSearchMode
+    std::int32_t localSearchMoves;
+    std::int32_t rankedAnts;
+    std::int32_t mmasGlobalBest;
+    std::int32_t mmasRestartIterations;
+    std::int32_t rngWords;              // Слов состояния на один генератор
+    std::int32_t rngCount;              // Генераторов: основной и по одному на поток
+    std::int32_t reserved;
+    double alpha;
+    double beta;
+    double rho;
+    double Q;
+    double elitistWeight;
+    double mmasPBest;
+    double acsQ0;
+    double acsXi;
+
+    // Состояние
+    double bestCost;
+    double pheromoneMin;
+    double pheromoneMax;
+    double initialPheromone;
+    double pheromoneScale;
+    double storedPheromoneMin;
+
+    // Секции
+    CheckpointSection vertices;         // x, y, visitCost (double) для каждой вершины
+    CheckpointSection distances;        // N x N double, только для EXPLICIT
+    CheckpointSection pheromones;       // Хранимые строки: N x N double или треугольник float
+    CheckpointSection bestRoute;        // int32 для каждой вершины (пусто, если маршрута нет)
+    CheckpointSection rngStates;        // uint32: rngCount состояний по rngWords слов
+};
+
+// Синхронная запись образа в файл: во временный файл рядом и переименование,
+// поэтому прерванная запись не портит прежнюю контрольную точку
+bool writeCheckpointFile(const std::string& path, const std::vector<char>& image, std::string& error);
+
+// Сохранение и загрузка состояния колонии
+bool saveCheckpoint(const std::string& path, const AntColony& colony, std::string& error);
+bool loadCheckpoint(const std::string& path, AntColony& colony, std::string& error);
+
+// Асинхронная запись контрольных точек. Образ снимается в потоке решателя
+// (копирование матриц), а запись на диск выполняет отдельный поток, поэтому
+// решатель не ждёт диска. Если запись не успевает, пишется только последний
+// образ: буферы передаются через TripleBuffer и переиспользуются.
+class CheckpointWriter {
+public:
+    explicit CheckpointWriter(const std::string& path);
+    ~CheckpointWriter();
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    // Период сохранения в итерациях и миллисекундах (0 - не использовать)
+    void setInterval(int iterations, int milliseconds);
+
+    // Вызывается после итерации: сохранение, если прошёл период. true - образ снят.
+    bool onIteration(const AntColony& colony);
+
+    // Немедленное сохранение (остановка, завершение)
+    void save(const AntColony& colony);
+
+    // Ожидание записи всех снятых образов
+    void flush();
+
+    const std::string& getPath() const { return path; }
+    int getSavedCount() const;
+    std::string getLastError() const;
+
+private:
+    void threadLoop();
+
+    std::string path;
+    int iterationInterval;
+    int timeInterval;
+    int lastIteration;                                // Итерация последнего сохранения
+    std::chrono::steady_clock::time_point lastSave;
+
+    TripleBuffer<std::vector<char>> images;
+    std::thread thread;
+    mutable std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::condition_variable idle;
+    bool pending;                                     // Под mutex: есть неписаный образ
+    bool writing;                                     // Под mutex: идёт запись
+    bool stopping;
+    int saved;                                        // Записано файлов
+    std::string lastError;
+};
+
+#endif // CHECKPOINT_H
@@ -0,0 +1,442 @@
+#include "choicekernel.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+
+// Векторные ядра собираются GCC/Clang для x86 с атрибутом target, поэтому
+// остальной код не требует флагов -mavx2 и работает на любом процессоре
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define ACO_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Целый показатель 0..4, для которого степень считается умножениями; иначе -1
+int smallIntegerPower(double exponent) {
+    if (exponent >= 0.0 && exponent <= 4.0 && exponent == std::floor(exponent)) {
+        return static_cast<int>(exponent);
+    }
+    return -1;
+}
+
+template <typename T>
+inline T integerPower(T x, int power) {
+    switch (power) {
+    case 0:
+        return T(1);
+    case 1:
+        return x;
+    case 2:
+        return x * x;
+    case 3:
+        return x * x * x;
+    default: {
+        T square = x * x;
+        return square * square;
+    }
+    }
+}
+
+// Скалярное ядро: целые показатели - умножениями, дробные - через std::pow
+template <typename T>
+double scalarWeights(const T* base, const T* factor, const char* visited,
+                     int n, double alpha, double beta, T* out) {
+    const int alphaPower = smallIntegerPower(alpha);
+    const int betaPower = smallIntegerPower(beta);
+    double sum = 0.0;
+
+    for (int j = 0; j < n; ++j) {
+        if (visited && visited[j]) {
+            out[j] = T(0);
+            continue;
+        }
+
+        double weight = alphaPower >= 0 ? integerPower<double>(base[j], alphaPower) : std::pow(base[j], alpha);
+        if (factor) {
+            weight *= betaPower >= 0 ? integerPower<double>(factor[j], betaPower) : std::pow(factor[j], beta);
+        }
+
+        out[j] = static_cast<T>(weight);
+        sum += out[j];
+    }
+
+    return sum;
+}
+
+#ifdef ACO_X86_SIMD
+
+// SSE4.1
+
+__attribute__((target("sse4.1")))
+inline __m128d powerSse41(__m128d x, int power) {
+    switch (power) {
+    case 0:
+        return _mm_set1_pd(1.0);
+    case 1:
+        return x;
+    case 2:
+        return _mm_mul_pd(x, x);
+    case 3:
+        return _mm_mul_pd(_mm_mul_pd(x, x), x);
+    default: {
+        __m128d square = _mm_mul_pd(x, x);
+        return _mm_mul_pd(square, square);
+    }
+    }
+}
+
+__attribute__((target("sse4.1")))
+inline __m128 powerSse41(__m128 x, int power) {
+    switch (power) {
+    case 0:
+        return _mm_set1_ps(1.0f);
+    case 1:
+        return x;
+    case 2:
+        return _mm_mul_ps(x, x);
+    case 3:
+        return _mm_mul_ps(_mm_mul_ps(x, x), x);
+    default: {
+        __m128 square = _mm_mul_ps(x, x);
+        return _mm_mul_ps(square, square);
+    }
+    }
+}
+
+__attribute__((target("sse4.1")))
+double weightsSse41(const double* base, const double* factor, const char* visited,
+                    int n, int alphaPower, int betaPower, double* out) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128d sum = _mm_setzero_pd();
+    int j = 0;
+
+    for (; j + 2 <= n; j += 2) {
+        __m128d weight = powerSse41(_mm_loadu_pd(base + j), alphaPower);
+        if (factor) {
+            weight = _mm_mul_pd(weight, powerSse41(_mm_loadu_pd(factor + j), betaPower));
+        }
+        if (visited) {
+            // Байты маски расширяются до 64-битных дорожек: непосещённые (0) -> все единицы
+            std::uint16_t bytes;
+            std::memcpy(&bytes, visited + j, sizeof(bytes));
+            __m128i lanes = _mm_cvtepu8_epi64(_mm_cvtsi32_si128(bytes));
+            weight = _mm_and_pd(weight, _mm_castsi128_pd(_mm_cmpeq_epi64(lanes, zero)));
+        }
+        _mm_storeu_pd(out + j, weight);
+        sum = _mm_add_pd(sum, weight);
+    }
+
+    double lanes[2];
+    _mm_storeu_pd(lanes, sum);
+    return lanes[0] + lanes[1] +
+           scalarWeights(base + j, factor ? factor + j : nullptr, visited ? visited + j : nullptr,
+                         n - j, alphaPower, betaPower, out + j);
+}
+
+__attribute__((target("sse4.1")))
+double weightsSse41(const float* base, const float* factor, const char* visited,
+                    int n, int alphaPower, int betaPower, float* out) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128 sum = _mm_setzero_ps();
+    int j = 0;
+
+    for (; j + 4 <= n; j += 4) {
+        __m128 weight = powerSse41(_mm_loadu_ps(base + j), alphaPower);
+        if (factor) {
+            weight = _mm_mul_ps(weight, powerSse41(_mm_loadu_ps(factor + j), betaPower));
+        }
+        if (visited) {
+            std::uint32_t bytes;
+            std::memcpy(&bytes, visited + j, sizeof(bytes));
+            __m128i lanes = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(static_cast<int>(bytes)));
+            weight = _mm_and_ps(weight, _mm_castsi128_ps(_mm_cmpeq_epi32(lanes, zero)));
+        }
+        _mm_storeu_ps(out + j, weight);
+        sum = _mm_add_ps(sum, weight);
+    }
+
+    float lanes[4];
+    _mm_storeu_ps(lanes, sum);
+    return static_cast<double>(lanes[0]) + lanes[1] + lanes[2] + lanes[3] +
+           scalarWeights(base + j, factor ? factor + j : nullptr, visited ? visited + j : nullptr,
+                         n - j, alphaPower, betaPower, out + j);
+}
+
+// AVX2
+
+__attribute__((target("avx2")))
+inline __m256d powerAvx2(__m256d x, int power) {
+    switch (power) {
+    case 0:
+        return _mm256_set1_pd(1.0);
+    case 1:
+        return x;
+    case 2:
+        return _mm256_mul_pd(x, x);
+    case 3:
+        return _mm256_mul_pd(_mm256_mul_pd(x, x), x);
+    default: {
+        __m256d square = _mm256_mul_pd(x, x);
+        return _mm256_mul_pd(square, square);
+    }
+    }
+}
+
+__attribute__((target("avx2")))
+inline __m256 powerAvx2(__m256 x, int power) {
+    switch (power) {
+    case 0:
+        return _mm256_set1_ps(1.0f);
+    case 1:
+        return x;
+    case 2:
+        return _mm256_mul_ps(x, x);
+    case 3:
+        return _mm256_mul_ps(_mm256_mul_ps(x, x), x);
+    default: {
+        __m256 square = _mm256_mul_ps(x, x);
+        return _mm256_mul_ps(square, square);
+    }
+    }
+}
+
+__attribute__((target("avx2")))
+double weightsAvx2(const double* base, const double* factor, const char* visited,
+                   int n, int alphaPower, int betaPower, double* out) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256d sum = _mm256_setzero_pd();
+    int j = 0;
+
+    for (; j + 4 <= n; j += 4) {
+        __m256d weight = powerAvx2(_mm256_loadu_pd(base + j), alphaPower);
+        if (factor) {
+            weight = _mm256_mul_pd(weight, powerAvx2(_mm256_loadu_pd(factor + j), betaPower));
+        }
+        if (visited) {
+            std::uint32_t bytes;
+            std::memcpy(&bytes, visited + j, sizeof(bytes));
+            __m256i lanes = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(static_cast<int>(bytes)));
+            weight = _mm256_and_pd(weight, _mm256_castsi256_pd(_mm256_cmpeq_epi64(lanes, zero)));
+        }
+        _mm256_storeu_pd(out + j, weight);
+        sum = _mm256_add_pd(sum, weight);
+    }
+
+    double lanes[4];
+    _mm256_storeu_pd(lanes, sum);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+           scalarWeights(base + j, factor ? factor + j : nullptr, visited ? visited + j : nullptr,
+                         n - j, alphaPower, betaPower, out + j);
+}
+
+__attribute__((target("avx2")))
+double weightsAvx2(const float* base, const float* factor, const char* visited,
+                   int n, int alphaPower, int betaPower, float* out) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256 sum = _mm256_setzero_ps();
+    int j = 0;
+
+    for (; j + 8 <= n; j += 8) {
+        __m256 weight = powerAvx2(_mm256_loadu_ps(base + j), alphaPower);
+        if (factor) {
+            weight = _mm256_mul_ps(weight, powerAvx2(_mm256_loadu_ps(factor + j), betaPower));
+        }
+        if (visited) {
+            __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(visited + j));
+            __m256i lanes = _mm256_cvtepu8_epi32(bytes);
+            weight = _mm256_and_ps(weight, _mm256_castsi256_ps(_mm256_cmpeq_epi32(lanes, zero)));
+        }
+        _mm256_storeu_ps(out + j, weight);
+        sum = _mm256_add_ps(sum, weight);
+    }
+
+    float lanes[8];
+    _mm256_storeu_ps(lanes, sum);
+    double total = 0.0;
+    for (float lane : lanes) {
+        total += lane;
+    }
+    return total + scalarWeights(base + j, factor ? factor + j : nullptr, visited ? visited + j : nullptr,
+                                 n - j, alphaPower, betaPower, out + j);
+}
+
+// AVX-512
+
+__attribute__((target("avx512f")))
+inline __m512d powerAvx512(__m512d x, int power) {
+    switch (power) {
+    case 0:
+        return _mm512_set1_pd(1.0);
+    case 1:
+        return x;
+    case 2:
+        return _mm512_mul_pd(x, x);
+    case 3:
+        return _mm512_mul_pd(_mm512_mul_pd(x, x), x);
+    default: {
+        __m512d square = _mm512_mul_pd(x, x);
+        return _mm512_mul_pd(square, square);
+    }
+    }
+}
+
+__attribute__((target("avx512f")))
+inline __m512 powerAvx512(__m512 x, int power) {
+    switch (power) {
+    case 0:
+        return _mm512_set1_ps(1.0f);
+    case 1:
+        return x;
+    case 2:
+        return _mm512_mul_ps(x, x);
+    case 3:
+        return _mm512_mul_ps(_mm512_mul_ps(x, x), x);
+    default: {
+        __m512 square = _mm512_mul_ps(x, x);
+        return _mm512_mul_ps(square, square);
+    }
+    }
+}
+
+__attribute__((target("avx512f")))
+double weightsAvx512(const double* base, const double* factor, const char* visited,
+                     int n, int alphaPower, int betaPower, double* out) {
+    const __m512i zero = _mm512_setzero_si512();
+    __m512d sum = _mm512_setzero_pd();
+    int j = 0;
+
+    for (; j + 8 <= n; j += 8) {
+        __m512d weight = powerAvx512(_mm512_loadu_pd(base + j), alphaPower);
+        if (factor) {
+            weight = _mm512_mul_pd(weight, powerAvx512(_mm512_loadu_pd(factor + j), betaPower));
+        }
+        if (visited) {
+            // Маска непосещённых вершин - в регистре маски, посещённые дорожки обнуляются
+            __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(visited + j));
+            __m512i lanes = _mm512_maskz_cvtepu8_epi64(0xFF, bytes);
+            __mmask8 unvisited = _mm512_cmpeq_epi64_mask(lanes, zero);
+            weight = _mm512_maskz_mov_pd(unvisited, weight);
+        }
+        _mm512_storeu_pd(out + j, weight);
+        sum = _mm512_add_pd(sum, weight);
+    }
+
+    double lanes[8];
+    _mm512_storeu_pd(lanes, sum);
+    double total = 0.0;
+    for (double lane : lanes) {
+        total += lane;
+    }
+    return total + scalarWeights(base + j, factor ? factor + j : nullptr, visited ? visited + j : nullptr,
+                                 n - j, alphaPower, betaPower, out + j);
+}
+
+__attribute__((target("avx512f")))
+double weightsAvx512(const float* base, const float* factor, const char* visited,
+                     int n, int alphaPower, int betaPower, float* out) {
+    const __m512i zero = _mm512_setzero_si512();
+    __m512 sum = _mm512_setzero_ps();
+    int j = 0;
+
+    for (; j + 16 <= n; j += 16) {
+        __m512 weight = powerAvx512(_mm512_loadu_ps(base + j), alphaPower);
+        if (factor) {
+            weight = _mm512_mul_ps(weight, powerAvx512(_mm512_loadu_ps(factor + j), betaPower));
+        }
+        if (visited) {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(visited + j));
+            __m512i lanes = _mm512_maskz_cvtepu8_epi32(0xFFFF, bytes);
+            __mmask16 unvisited = _mm512_cmpeq_epi32_mask(lanes, zero);
+            weight = _mm512_maskz_mov_ps(unvisited, weight);
+        }
+        _mm512_storeu_ps(out + j, weight);
+        sum = _mm512_add_ps(sum, weight);
+    }
+
+    float lanes[16];
+    _mm512_storeu_ps(lanes, sum);
+    double total = 0.0;
+    for (float lane : lanes) {
+        total += lane;
+    }
+    return total + scalarWeights(base + j, factor ? factor + j : nullptr, visited ? visited + j : nullptr,
+                                 n - j, alphaPower, betaPower, out + j);
+}
+
+#endif // ACO_X86_SIMD
+
+template <typename T>
+double dispatchWeights(SimdIsa isa, const T* base, const T* factor, const char* visited,
+                       int n, double alpha, double beta, T* out) {
+    const int alphaPower = smallIntegerPower(alpha);
+    const int betaPower = factor ? smallIntegerPower(beta) : 0;
+
+    if (alphaPower < 0 || betaPower < 0 || !isSimdIsaSupported(isa)) {
+        return scalarWeights(base, factor, visited, n, alpha, beta, out);
+    }
+
+    switch (isa) {
+#ifdef ACO_X86_SIMD
+    case SimdIsa::Sse41:
+        return weightsSse41(base, factor, visited, n, alphaPower, betaPower, out);
+    case SimdIsa::Avx2:
+        return weightsAvx2(base, factor, visited, n, alphaPower, betaPower, out);
+    case SimdIsa::Avx512:
+        return weightsAvx512(base, factor, visited, n, alphaPower, betaPower, out);
+#endif
+    default:
+        return scalarWeights(base, factor, visited, n, alpha, beta, out);
+    }
+}
+
+} // namespace
+
+bool isSimdIsaSupported(SimdIsa isa) {
+#ifdef ACO_X86_SIMD
+    // Возможности процессора определяются один раз
+    static const bool supported[] = {
+        true,
+        (__builtin_cpu_init(), __builtin_cpu_supports("sse4.1") != 0),
+        __builtin_cpu_supports("avx2") != 0,
+        __builtin_cpu_supports("avx512f") != 0
+    };
+    return supported[static_cast<int>(isa)];
+#else
+    return isa == SimdIsa::Scalar;
+#endif
+}
+
+SimdIsa detectSimdIsa() {
+    for (SimdIsa isa : { SimdIsa::Avx512, SimdIsa::Avx2, SimdIsa::Sse41 }) {
+        if (isSimdIsaSupported(isa)) {
+            return isa;
+        }
+    }
+    return SimdIsa::Scalar;
+}
+
+const char* simdIsaName(SimdIsa isa) {
+    switch (isa) {
+    case SimdIsa::Scalar:
+        return "scalar";
+    case SimdIsa::Sse41:
+        return "sse4";
+    case SimdIsa::Avx2:
+        return "avx2";
+    case SimdIsa::Avx512:
+        return "avx512";
+    }
+    return "unknown";
+}
+
+double maskedWeights(SimdIsa isa, const double* base, const double* factor, const char* visited,
+                     int n, double alpha, double beta, double* out) {
+    return dispatchWeights(isa, base, factor, visited, n, alpha, beta, out);
+}
+
+double maskedWeights(SimdIsa isa, const float* base, const float* factor, const char* visited,
+                     int n, double alpha, double beta, float* out) {
+    return dispatchWeights(isa, base, factor, visited, n, alpha, beta, out);
+}
@@ -0,0 +1,34 @@
+#ifndef CHOICEKERNEL_H
+#define CHOICEKERNEL_H
+
+// Набор инструкций для векторных ядер (выбирается во время выполнения)
+enum class SimdIsa {
+    Scalar,     // Обычный цикл с std::pow
+    Sse41,      // SSE4.1: 2 double / 4 float
+    Avx2,       // AVX2: 4 double / 8 float
+    Avx512      // AVX-512F: 8 double / 16 float
+};
+
+// Лучший набор инструкций, поддерживаемый процессором
+SimdIsa detectSimdIsa();
+
+// Поддерживает ли процессор (и сборка) данный набор инструкций
+bool isSimdIsaSupported(SimdIsa isa);
+
+// Имя набора инструкций для вывода ("scalar", "sse4", "avx2", "avx512")
+const char* simdIsaName(SimdIsa isa);
+
+// Веса строки за один проход: out[j] = base[j]^alpha * factor[j]^beta,
+// а для посещённых вершин (visited[j] != 0) - ноль. Возвращает сумму out.
+// factor и visited могут быть nullptr (множитель 1, маска не применяется).
+// Векторные ядра используются для целых показателей 0..4 (степень
+// вычисляется умножениями, например beta = 2 - квадрат); при дробных
+// показателях и неподдерживаемом наборе инструкций работает скалярный цикл.
+// Порядок сложения в векторных ядрах другой, поэтому сумма совпадает со
+// скалярной только с точностью до округления.
+double maskedWeights(SimdIsa isa, const double* base, const double* factor, const char* visited,
+                     int n, double alpha, double beta, double* out);
+double maskedWeights(SimdIsa isa, const float* base, const float* factor, const char* visited,
+                     int n, double alpha, double beta, float* out);
+
+#endif // CHOICEKERNEL_H
@@ -0,0 +1,58 @@
+#include "configfile.h"
+#include <fstream>
+#include <sstream>
+
+bool readConfigFile(const std::string& path, std::vector<ConfigEntry>& entries, std::string& error) {
+    std::ifstream input(path);
+    if (!input) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    entries.clear();
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(input, line)) {
+        ++lineNumber;
+        std::size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+
+        std::istringstream fields(line);
+        ConfigEntry entry;
+        if (!(fields >> entry.key)) {
+            continue;
+        }
+        if (!(fields >> entry.value)) {
+            error = path + ":" + std::to_string(lineNumber) + ": missing value for " + entry.key;
+            return false;
+        }
+        entries.push_back(entry);
+    }
+    return true;
+}
+
+bool writeConfigFile(const std::string& path, const std::vector<ConfigEntry>& entries,
+                     const std::string& comment, std::string& error) {
+    std::ofstream output(path);
+    if (!output) {
+        error = "cannot create " + path;
+        return false;
+    }
+
+    std::istringstream lines(comment);
+    std::string line;
+    while (std::getline(lines, line)) {
+        output << "# " << line << "\n";
+    }
+    for (const ConfigEntry& entry : entries) {
+        output << entry.key << " " << entry.value << "\n";
+    }
+
+    if (!output) {
+        error = "cannot write " + path;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,22 @@
+#ifndef CONFIGFILE_H
+#define CONFIGFILE_H
+
+#include <string>
+#include <vector>
+
+// Запись файла настроек: ключ и значение
+struct ConfigEntry {
+    std::string key;
+    std::string value;
+};
+
+// Файл настроек решателя: строка "ключ значение" на параметр, '#' начинает
+// комментарий. Ключи - длинные опции aco-solve без "--" (alpha, rho, variant...),
+// поэтому файл подходит и для консольного решателя, и для интерфейса.
+bool readConfigFile(const std::string& path, std::vector<ConfigEntry>& entries, std::string& error);
+
+// Запись настроек; comment пишется в начало файла строками с '#'
+bool writeConfigFile(const std::string& path, const std::vector<ConfigEntry>& entries,
+                     const std::string& comment, std::string& error);
+
+#endif // CONFIGFILE_H
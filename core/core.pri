@@ -0,0 +1,14 @@
+# Подключение статической библиотеки решателя к приложению
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+CONFIG += thread
+
+win32:CONFIG(release, debug|release): ACOCORE_DIR = $$OUT_PWD/../core/release
+else:win32:CONFIG(debug, debug|release): ACOCORE_DIR = $$OUT_PWD/../core/debug
+else: ACOCORE_DIR = $$OUT_PWD/../core
+
+LIBS += -L$$ACOCORE_DIR -lacocore
+
+win32-g++|!win32: PRE_TARGETDEPS += $$ACOCORE_DIR/libacocore.a
+else: PRE_TARGETDEPS += $$ACOCORE_DIR/acocore.lib
@@ -0,0 +1,45 @@
+TEMPLATE = lib
+TARGET = acocore
+
+CONFIG += staticlib c++17 thread
+CONFIG -= qt
+
+SOURCES += \
+    antcolony.cpp \
+    checkpoint.cpp \
+    choicekernel.cpp \
+    configfile.cpp \
+    instance.cpp \
+    islandmodel.cpp \
+    kdtree.cpp \
+    localsearch.cpp \
+    mappedfile.cpp \
+    solverrunner.cpp \
+    statisticslog.cpp \
+    termination.cpp \
+    threadpool.cpp \
+    tracelog.cpp \
+    tsplib.cpp \
+    tuner.cpp
+
+HEADERS += \
+    antcolony.h \
+    checkpoint.h \
+    choicekernel.h \
+    configfile.h \
+    distancematrix.h \
+    fenwicktree.h \
+    instance.h \
+    islandmodel.h \
+    kdtree.h \
+    localsearch.h \
+    mappedfile.h \
+    matrix.h \
+    solverrunner.h \
+    statisticslog.h \
+    termination.h \
+    threadpool.h \
+    tracelog.h \
+    triplebuffer.h \
+    tsplib.h \
+    tuner.h
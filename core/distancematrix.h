@@ -0,0 +1,115 @@
+#ifndef DISTANCEMATRIX_H
+#define DISTANCEMATRIX_H
+
+#include <cstddef>
+#include <cstdint>
+#include "matrix.h"
+
+// Матрица расстояний колонии. В полном режиме это Matrix<double>, в компактном
+// (только для симметричных задач) - верхний треугольник: int32 для целочисленных
+// метрик TSPLIB и float для остальных. Чтение d(i, j) одинаково для всех форм.
+class DistanceMatrix {
+public:
+    // Форма хранения
+    enum Storage {
+        Dense,          // Полная матрица double
+        PackedInt,      // Верхний треугольник int32
+        PackedFloat     // Верхний треугольник float
+    };
+
+    DistanceMatrix() : storage(Dense) {}
+
+    // Новая матрица n x n в заданной форме, заполненная нулями
+    void reset(int n, Storage newStorage) {
+        storage = newStorage;
+        dense = Matrix<double>();
+        packedInt = SymmetricMatrix<std::int32_t>();
+        packedFloat = SymmetricMatrix<float>();
+
+        switch (storage) {
+        case Dense:
+            dense.resize(n, n, 0.0);
+            break;
+        case PackedInt:
+            packedInt.resize(n, 0);
+            break;
+        case PackedFloat:
+            packedFloat.resize(n, 0.0f);
+            break;
+        }
+    }
+
+    // Изменение размера с сохранением расстояний общей части (новые - нули)
+    void resizePreserving(int n) {
+        switch (storage) {
+        case Dense:
+            dense.resizePreserving(n, n, 0.0);
+            break;
+        case PackedInt:
+            packedInt.resizePreserving(n, 0);
+            break;
+        case PackedFloat:
+            packedFloat.resizePreserving(n, 0.0f);
+            break;
+        }
+    }
+
+    double operator()(int i, int j) const {
+        switch (storage) {
+        case PackedInt:
+            return packedInt(i, j);
+        case PackedFloat:
+            return packedFloat(i, j);
+        default:
+            return dense(i, j);
+        }
+    }
+
+    // Запись d(i, j); в упакованной форме это одновременно и d(j, i)
+    void set(int i, int j, double value) {
+        switch (storage) {
+        case PackedInt:
+            packedInt(i, j) = static_cast<std::int32_t>(value);
+            break;
+        case PackedFloat:
+            packedFloat(i, j) = static_cast<float>(value);
+            break;
+        case Dense:
+            dense(i, j) = value;
+            break;
+        }
+    }
+
+    // Помещается ли расстояние в PackedInt без потери точности
+    static bool fitsInt(double value) {
+        return value >= INT32_MIN && value <= INT32_MAX &&
+               value == static_cast<double>(static_cast<std::int32_t>(value));
+    }
+
+    Storage getStorage() const { return storage; }
+    bool isPacked() const { return storage != Dense; }
+
+    int size() const {
+        switch (storage) {
+        case PackedInt:
+            return packedInt.rows();
+        case PackedFloat:
+            return packedFloat.rows();
+        default:
+            return dense.rows();
+        }
+    }
+
+    // Объём хранимых данных в байтах
+    std::size_t bytes() const {
+        return dense.bytes() + packedInt.bytes() + packedFloat.bytes();
+    }
+
+private:
+    Storage storage;
+    Matrix<double> dense;
+    SymmetricMatrix<std::int32_t> packedInt;
+    SymmetricMatrix<float> packedFloat;
+};
+
+#endif // DISTANCEMATRIX_H
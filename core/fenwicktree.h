@@ -0,0 +1,67 @@
+#ifndef FENWICKTREE_H
+#define FENWICKTREE_H
+
+// Дерево Фенвика (дерево частичных сумм) поверх внешнего массива из n узлов.
+// Узел k (1..n) хранится в nodes[k - 1] и содержит сумму весов
+// [k - lowbit(k), k). Изменение веса и поиск по префиксной сумме - O(log n).
+// Для чтения достаточно FenwickTree<const T>.
+template <typename T>
+class FenwickTree {
+public:
+    FenwickTree(T* nodes, int n) : nodes(nodes), n(n) {}
+
+    // Построение по весам за O(n)
+    void build(const T* weights) {
+        for (int k = 1; k <= n; ++k) {
+            nodes[k - 1] = weights[k - 1];
+        }
+        for (int k = 1; k <= n; ++k) {
+            int parent = k + (k & -k);
+            if (parent <= n) {
+                nodes[parent - 1] += nodes[k - 1];
+            }
+        }
+    }
+
+    // Изменение веса элемента i на delta
+    void add(int i, T delta) {
+        for (int k = i + 1; k <= n; k += k & -k) {
+            nodes[k - 1] += delta;
+        }
+    }
+
+    // Сумма всех весов
+    double total() const {
+        double sum = 0.0;
+        for (int k = n; k > 0; k -= k & -k) {
+            sum += nodes[k - 1];
+        }
+        return sum;
+    }
+
+    // Элемент, на который попадает value в [0, total()): первый i, у которого
+    // сумма весов [0, i] больше value. Ошибки округления ограничиваются n - 1.
+    int find(double value) const {
+        int position = 0;
+        int step = 1;
+        while (step * 2 <= n) {
+            step *= 2;
+        }
+
+        // Спуск от старшего бита: position - количество элементов левее ответа
+        for (; step > 0; step /= 2) {
+            int next = position + step;
+            if (next <= n && nodes[next - 1] <= value) {
+                value -= nodes[next - 1];
+                position = next;
+            }
+        }
+        return position < n ? position : n - 1;
+    }
+
+private:
+    T* nodes;
+    int n;
+};
+
+#endif // FENWICKTREE_H
@@ -0,0 +1,48 @@
+#include "instance.h"
+#include <cmath>
+
+namespace {
+
+// Число π в определении GEO из TSPLIB: опубликованные длины оптимальных
+// маршрутов GEO-задач посчитаны именно с этим округлённым значением
+const double TsplibGeoPi = 3.141592;
+
+// Перевод координаты GEO (DDD.MM) в радианы
+double geoToRadians(double value) {
+    double degrees = std::trunc(value);
+    double minutes = value - degrees;
+    return TsplibGeoPi * (degrees + 5.0 * minutes / 3.0) / 180.0;
+}
+
+} // namespace
+
+double metricDistance(DistanceMetric metric, const Point& p1, const Point& p2) {
+    double dx = p1.x - p2.x;
+    double dy = p1.y - p2.y;
+
+    switch (metric) {
+    case DistanceMetric::Euclidean:
+        return std::sqrt(dx * dx + dy * dy);
+    case DistanceMetric::Euc2D:
+        return std::floor(std::sqrt(dx * dx + dy * dy) + 0.5);
+    case DistanceMetric::Ceil2D:
+        return std::ceil(std::sqrt(dx * dx + dy * dy));
+    case DistanceMetric::Att: {
+        double r = std::sqrt((dx * dx + dy * dy) / 10.0);
+        double t = std::floor(r + 0.5);
+        return t < r ? t + 1.0 : t;
+    }
+    case DistanceMetric::Geo: {
+        const double earthRadius = 6378.388;
+        double lat1 = geoToRadians(p1.x), lon1 = geoToRadians(p1.y);
+        double lat2 = geoToRadians(p2.x), lon2 = geoToRadians(p2.y);
+        double q1 = std::cos(lon1 - lon2);
+        double q2 = std::cos(lat1 - lat2);
+        double q3 = std::cos(lat1 + lat2);
+        return std::trunc(earthRadius * std::acos(0.5 * ((1.0 + q1) * q2 - (1.0 - q1) * q3)) + 1.0);
+    }
+    case DistanceMetric::Explicit:
+        break;
+    }
+    return 0.0;
+}
@@ -0,0 +1,60 @@
+#ifndef INSTANCE_H
+#define INSTANCE_H
+
+#include <string>
+#include <vector>
+#include "matrix.h"
+
+// Точка на плоскости
+struct Point {
+    double x;
+    double y;
+
+    Point() : x(0.0), y(0.0) {}
+    Point(double x, double y) : x(x), y(y) {}
+};
+
+// Структура вершины графа
+struct Vertex {
+    int id;                  // Идентификатор вершины
+    Point position;          // Координаты на плоскости
+    double visitCost;        // Стоимость посещения вершины
+
+    Vertex(int i, Point pos, double cost)
+        : id(i), position(pos), visitCost(cost) {}
+};
+
+// Функция расстояния между вершинами (метрики TSPLIB)
+enum class DistanceMetric {
+    Euclidean,     // Евклидово расстояние без округления (случайные графы)
+    Euc2D,         // EUC_2D: округление до ближайшего целого
+    Ceil2D,        // CEIL_2D: округление вверх
+    Att,           // ATT: псевдоевклидово расстояние
+    Geo,           // GEO: расстояние по поверхности Земли
+    Explicit       // EXPLICIT: расстояния заданы матрицей
+};
+
+// Описание задачи, загруженной из файла
+struct Instance {
+    std::string name;                  // Имя задачи
+    std::vector<Vertex> vertices;      // Вершины (для EXPLICIT - координаты отображения)
+    DistanceMetric metric = DistanceMetric::Euclidean;
+    Matrix<double> explicitDistances;  // Матрица расстояний (только для EXPLICIT)
+};
+
+// Расстояние между двумя точками в заданной метрике (кроме EXPLICIT)
+double metricDistance(DistanceMetric metric, const Point& p1, const Point& p2);
+
+// Является ли метрика монотонной функцией евклидова расстояния на плоскости
+// (тогда ближайших соседей можно искать по координатам)
+inline bool isPlanarMetric(DistanceMetric metric) {
+    return metric != DistanceMetric::Geo && metric != DistanceMetric::Explicit;
+}
+
+// Даёт ли метрика целые расстояния (округление nint, ceil и т.п.)
+inline bool isIntegerMetric(DistanceMetric metric) {
+    return metric == DistanceMetric::Euc2D || metric == DistanceMetric::Ceil2D ||
+           metric == DistanceMetric::Att || metric == DistanceMetric::Geo;
+}
+
+#endif // INSTANCE_H
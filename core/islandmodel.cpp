@@ -0,0 +1,160 @@
+#include "islandmodel.h"
+
+IslandModel::IslandModel()
+    : migrationScheme(MigrationScheme::Ring), migrationInterval(20), pheromoneWeight(0.5),
+    bestIsland(0), migrations(0)
+{
+}
+
+void IslandModel::addIsland(std::unique_ptr<AntColony> colony) {
+    islands.push_back(std::move(colony));
+    migrants.resize(islands.size());
+    pool.reset(islands.size() > 1 ? new ThreadPool(static_cast<int>(islands.size())) : nullptr);
+}
+
+void IslandModel::setMigration(MigrationScheme scheme, int interval, double weight) {
+    migrationScheme = scheme;
+    migrationInterval = std::max(0, interval);
+    pheromoneWeight = std::min(std::max(weight, 0.0), 1.0);
+}
+
+void IslandModel::generateRandomGraph(int width, int height) {
+    if (islands.empty()) {
+        return;
+    }
+
+    // Граф генерирует первый остров, остальные получают его вершины
+    islands[0]->generateRandomGraph(width, height);
+    for (size_t i = 1; i < islands.size(); ++i) {
+        islands[i]->setGraph(islands[0]->getVertices());
+    }
+    bestIsland = 0;
+}
+
+void IslandModel::setGraph(const std::vector<Vertex>& graphVertices) {
+    for (auto& island : islands) {
+        island->setGraph(graphVertices);
+    }
+    bestIsland = 0;
+}
+
+void IslandModel::setInstance(const Instance& instance) {
+    for (auto& island : islands) {
+        island->setInstance(instance);
+    }
+    bestIsland = 0;
+}
+
+void IslandModel::runIteration() {
+    if (islands.empty() || isFinished()) {
+        return;
+    }
+    termination.beginIteration();
+
+    if (pool) {
+        pool->run([this](int island) { islands[island]->runIteration(); });
+    } else {
+        islands[0]->runIteration();
+    }
+
+    int iteration = getCurrentIteration();
+    if (migrationInterval > 0 && iteration % migrationInterval == 0 && !isFinished()) {
+        migrate();
+    }
+
+    updateBestIsland();
+    termination.endIteration(iteration, getMaxIterations(), getBestCost());
+}
+
+void IslandModel::run() {
+    while (!islands.empty() && !isFinished()) {
+        runIteration();
+    }
+}
+
+void IslandModel::reset() {
+    for (auto& island : islands) {
+        island->reset();
+    }
+    bestIsland = 0;
+    migrations = 0;
+    termination.reset();
+}
+
+TerminationReason IslandModel::getTerminationReason() const {
+    if (termination.getReason() != TerminationReason::None) {
+        return termination.getReason();
+    }
+    return isFinished() ? islands[bestIsland]->getTerminationReason() : TerminationReason::None;
+}
+
+bool IslandModel::isFinished() const {
+    if (termination.getReason() != TerminationReason::None) {
+        return true;
+    }
+    for (const auto& island : islands) {
+        if (!island->isFinished()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+double IslandModel::getBestCost() const {
+    return islands.empty() ? std::numeric_limits<double>::max() : islands[bestIsland]->getBestCost();
+}
+
+const std::vector<int>& IslandModel::getBestRoute() const {
+    static const std::vector<int> empty;
+    return islands.empty() ? empty : islands[bestIsland]->getBestRoute();
+}
+
+void IslandModel::updateBestIsland() {
+    for (size_t i = 0; i < islands.size(); ++i) {
+        if (islands[i]->getBestCost() < islands[bestIsland]->getBestCost()) {
+            bestIsland = static_cast<int>(i);
+        }
+    }
+}
+
+void IslandModel::migrate() {
+    const int count = static_cast<int>(islands.size());
+    if (count < 2) {
+        return;
+    }
+    ++migrations;
+
+    if (migrationScheme == MigrationScheme::MergePheromone) {
+        // Среднее по островам в истинных значениях (с учётом ленивого испарения)
+        const int n = islands[0]->getNumVertices();
+        meanPheromones.resize(n, n, 0.0);
+
+        for (int i = 0; i < n; ++i) {
+            double* row = meanPheromones.row(i);
+            for (int j = 0; j < n; ++j) {
+                double sum = 0.0;
+                for (const auto& island : islands) {
+                    sum += island->getPheromone(i, j);
+                }
+                row[j] = sum / count;
+            }
+        }
+
+        pool->run([this](int island) { islands[island]->blendPheromones(meanPheromones, pheromoneWeight); });
+        return;
+    }
+
+    // Маршруты копируются до приёма: приём меняет лучший маршрут получателя
+    updateBestIsland();
+    for (int i = 0; i < count; ++i) {
+        migrants[i] = islands[i]->getBestRoute();
+    }
+
+    pool->run([this, count](int island) {
+        if (migrationScheme == MigrationScheme::Ring) {
+            islands[island]->importRoute(migrants[(island + count - 1) % count]);
+        } else if (island != bestIsland) {
+            islands[island]->importRoute(migrants[bestIsland]);
+        }
+    });
+}
@@ -0,0 +1,82 @@
+#ifndef ISLANDMODEL_H
+#define ISLANDMODEL_H
+
+#include <memory>
+#include <vector>
+#include "antcolony.h"
+#include "matrix.h"
+#include "threadpool.h"
+
+// Обмен между островами
+enum class MigrationScheme {
+    Ring,               // Лучший маршрут острова i передаётся острову i + 1
+    FullyConnected,     // Лучший маршрут всех островов передаётся каждому острову
+    MergePheromone      // Феромоны каждого острова сдвигаются к среднему по островам
+};
+
+// Островная модель: несколько независимых колоний на одном графе, каждая в своём
+// потоке. Феромоны у островов свои, поэтому между итерациями потоки не
+// синхронизируются; раз в migrationInterval итераций острова обмениваются
+// лучшими маршрутами (или смешивают феромоны). Параметры и зёрна колоний
+// задаёт вызывающий код, поэтому острова могут отличаться alpha, beta и rho.
+class IslandModel {
+public:
+    IslandModel();
+
+    IslandModel(const IslandModel&) = delete;
+    IslandModel& operator=(const IslandModel&) = delete;
+
+    // Добавление острова (до задания графа). Потоки колоний лучше ограничить
+    // одним: каждый остров и так выполняется в отдельном потоке.
+    void addIsland(std::unique_ptr<AntColony> colony);
+    int getIslandCount() const { return static_cast<int>(islands.size()); }
+    AntColony& getIsland(int island) { return *islands[island]; }
+    const AntColony& getIsland(int island) const { return *islands[island]; }
+
+    // Способ обмена, период в итерациях (0 - без обмена) и доля среднего при смешивании феромонов
+    void setMigration(MigrationScheme scheme, int interval, double pheromoneWeight = 0.5);
+    MigrationScheme getMigrationScheme() const { return migrationScheme; }
+    int getMigrationInterval() const { return migrationInterval; }
+
+    // Один и тот же граф для всех островов
+    void generateRandomGraph(int width, int height);
+    void setGraph(const std::vector<Vertex>& graphVertices);
+    void setInstance(const Instance& instance);
+
+    // Итерация на всех островах параллельно; после каждой migrationInterval-й - обмен
+    void runIteration();
+    void run();
+    void reset();
+
+    // Досрочное завершение по лучшему маршруту всех островов (перезапуски
+    // при застое задаются каждому острову)
+    void setTermination(const TerminationCriteria& criteria) { termination.setCriteria(criteria); }
+    TerminationReason getTerminationReason() const;
+
+    bool isFinished() const;
+    int getCurrentIteration() const { return islands.empty() ? 0 : islands[0]->getCurrentIteration(); }
+    int getMaxIterations() const { return islands.empty() ? 0 : islands[0]->getMaxIterations(); }
+    int getMigrationCount() const { return migrations; }
+
+    // Лучший маршрут среди всех островов и остров, который его нашёл
+    int getBestIsland() const { return bestIsland; }
+    double getBestCost() const;
+    const std::vector<int>& getBestRoute() const;
+
+private:
+    void migrate();
+    void updateBestIsland();
+
+    std::vector<std::unique_ptr<AntColony>> islands;
+    std::unique_ptr<ThreadPool> pool;     // По потоку на остров
+    MigrationScheme migrationScheme;
+    int migrationInterval;
+    double pheromoneWeight;
+    int bestIsland;
+    int migrations;                       // Выполнено обменов с последнего сброса
+    std::vector<std::vector<int>> migrants;  // Маршруты, отправляемые островами
+    Matrix<double> meanPheromones;        // Средние феромоны (MergePheromone)
+    TerminationMonitor termination;
+};
+
+#endif // ISLANDMODEL_H
@@ -0,0 +1,95 @@
+#include "kdtree.h"
+#include <algorithm>
+
+KdTree::KdTree(const std::vector<Vertex>& vertices) {
+    const int n = static_cast<int>(vertices.size());
+    xs.reserve(n);
+    ys.reserve(n);
+    order.resize(n);
+
+    for (int i = 0; i < n; ++i) {
+        xs.push_back(vertices[i].position.x);
+        ys.push_back(vertices[i].position.y);
+        order[i] = i;
+    }
+
+    build(0, n, 0);
+}
+
+void KdTree::build(int begin, int end, int depth) {
+    if (end - begin <= 1) {
+        return;
+    }
+
+    // Разбиение по медиане: чётная глубина - по X, нечётная - по Y
+    const std::vector<double>& coords = (depth % 2 == 0) ? xs : ys;
+    int mid = begin + (end - begin) / 2;
+
+    std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+                     [&coords](int a, int b) { return coords[a] < coords[b]; });
+
+    build(begin, mid, depth + 1);
+    build(mid + 1, end, depth + 1);
+}
+
+void KdTree::nearest(int index, int k, std::vector<int>& result) const {
+    result.clear();
+    heap.clear();
+
+    k = std::min(k, static_cast<int>(order.size()) - 1);
+    if (k <= 0) {
+        return;
+    }
+
+    search(0, static_cast<int>(order.size()), 0, xs[index], ys[index], index, k);
+
+    // Куча хранит наиболее удалённого кандидата в вершине
+    std::sort_heap(heap.begin(), heap.end());
+    for (const auto& candidate : heap) {
+        result.push_back(candidate.second);
+    }
+}
+
+void KdTree::search(int begin, int end, int depth, double x, double y, int exclude, int k) const {
+    if (begin >= end) {
+        return;
+    }
+
+    int mid = begin + (end - begin) / 2;
+    int point = order[mid];
+
+    // Проверка точки разбиения
+    if (point != exclude) {
+        double dx = xs[point] - x;
+        double dy = ys[point] - y;
+        double dist2 = dx * dx + dy * dy;
+
+        if (static_cast<int>(heap.size()) < k) {
+            heap.emplace_back(dist2, point);
+            std::push_heap(heap.begin(), heap.end());
+        } else if (dist2 < heap.front().first) {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.back() = std::make_pair(dist2, point);
+            std::push_heap(heap.begin(), heap.end());
+        }
+    }
+
+    // Сначала спускаемся в ту половину, где лежит точка запроса
+    double diff = (depth % 2 == 0) ? (x - xs[point]) : (y - ys[point]);
+    bool leftFirst = diff < 0;
+
+    if (leftFirst) {
+        search(begin, mid, depth + 1, x, y, exclude, k);
+    } else {
+        search(mid + 1, end, depth + 1, x, y, exclude, k);
+    }
+
+    // Вторая половина нужна, только если разделяющая прямая ближе текущего k-го соседа
+    if (static_cast<int>(heap.size()) < k || diff * diff < heap.front().first) {
+        if (leftFirst) {
+            search(mid + 1, end, depth + 1, x, y, exclude, k);
+        } else {
+            search(begin, mid, depth + 1, x, y, exclude, k);
+        }
+    }
+}
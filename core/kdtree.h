@@ -0,0 +1,31 @@
+#ifndef KDTREE_H
+#define KDTREE_H
+
+#include <vector>
+#include <utility>
+#include "instance.h"
+
+// Двумерное k-d дерево по координатам вершин для поиска ближайших соседей.
+// Дерево неявное: хранится только перестановка индексов, упорядоченная
+// медианными разбиениями, поэтому построение не выделяет узлов.
+class KdTree {
+public:
+    explicit KdTree(const std::vector<Vertex>& vertices);
+
+    // k ближайших соседей вершины index (сама вершина исключается),
+    // результат упорядочен по возрастанию расстояния
+    void nearest(int index, int k, std::vector<int>& result) const;
+
+private:
+    void build(int begin, int end, int depth);
+    void search(int begin, int end, int depth, double x, double y, int exclude, int k) const;
+
+    std::vector<double> xs;                 // Координаты X
+    std::vector<double> ys;                 // Координаты Y
+    std::vector<int> order;                 // Индексы вершин в порядке дерева
+
+    // Буфер кандидатов при поиске (квадрат расстояния, индекс)
+    mutable std::vector<std::pair<double, int>> heap;
+};
+
+#endif // KDTREE_H
@@ -0,0 +1,259 @@
+#include "localsearch.h"
+#include <algorithm>
+
+namespace {
+
+// Минимальное улучшение, при котором ход применяется
+const double Epsilon = 1e-9;
+
+// Максимальная длина переносимого участка в Or-opt
+const int MaxSegmentLength = 3;
+
+} // namespace
+
+LocalSearch::LocalSearch()
+    : route(nullptr), distances(nullptr), neighbours(nullptr), numNeighbours(0), n(0),
+    symmetric(false), queueHead(0), queueSize(0)
+{
+}
+
+double LocalSearch::improve(std::vector<int>& tour, const DistanceMatrix& distanceMatrix,
+                            const int* neighbourLists, int neighbourCount, bool symmetricDistances, int moves) {
+    n = static_cast<int>(tour.size());
+    if (n < MaxSegmentLength + 3 || neighbourCount <= 0) {
+        return 0.0;
+    }
+
+    route = tour.data();
+    distances = &distanceMatrix;
+    neighbours = neighbourLists;
+    numNeighbours = neighbourCount;
+    symmetric = symmetricDistances;
+
+    // Изначально проверяются все вершины
+    position.resize(n);
+    active.assign(n, 1);
+    queue.resize(n);
+    for (int i = 0; i < n; ++i) {
+        position[route[i]] = i;
+        queue[i] = route[i];
+    }
+    queueHead = 0;
+    queueSize = n;
+
+    bool useTwoOpt = symmetric && (moves & LocalSearchTwoOpt);
+    bool useOrOpt = (moves & LocalSearchOrOpt) != 0;
+    int start = route[0];
+    double totalDelta = 0.0;
+
+    while (queueSize > 0) {
+        int a = queue[queueHead];
+        queueHead = (queueHead + 1) % n;
+        --queueSize;
+        active[a] = 0;
+
+        // Вершина проверяется, пока находятся улучшающие ходы
+        while (true) {
+            double delta = 0.0;
+            if (useTwoOpt) {
+                delta = improveTwoOpt(a);
+            }
+            if (delta == 0.0 && useOrOpt) {
+                delta = improveOrOpt(a);
+            }
+            if (delta == 0.0) {
+                break;
+            }
+            totalDelta += delta;
+        }
+    }
+
+    // Возврат стартовой вершины в начало маршрута
+    std::rotate(tour.begin(), tour.begin() + position[start], tour.end());
+    return totalDelta;
+}
+
+void LocalSearch::activate(int vertex) {
+    if (active[vertex]) {
+        return;
+    }
+    active[vertex] = 1;
+    queue[(queueHead + queueSize) % n] = vertex;
+    ++queueSize;
+}
+
+double LocalSearch::improveTwoOpt(int a) {
+    const int* list = neighbours + static_cast<size_t>(a) * numNeighbours;
+
+    // Ребро a-b (к следующей, затем к предыдущей вершине) заменяется на a-c
+    for (int direction = 0; direction < 2; ++direction) {
+        int b = direction == 0 ? next(a) : prev(a);
+        double removed = distance(a, b);
+
+        for (int k = 0; k < numNeighbours; ++k) {
+            int c = list[k];
+            double added = distance(a, c);
+
+            // Соседи упорядочены по расстоянию: дальше выигрыша нет
+            if (added >= removed - Epsilon) {
+                break;
+            }
+
+            int d = direction == 0 ? next(c) : prev(c);
+            if (c == b || d == a) {
+                continue;
+            }
+
+            double delta = added + distance(b, d) - removed - distance(c, d);
+            if (delta < -Epsilon) {
+                // a b ... c d -> a c ... b d (и зеркально для предыдущей вершины)
+                if (direction == 0) {
+                    reverse(position[b], position[c]);
+                } else {
+                    reverse(position[a], position[d]);
+                }
+                activate(a);
+                activate(b);
+                activate(c);
+                activate(d);
+                return delta;
+            }
+        }
+    }
+
+    return 0.0;
+}
+
+double LocalSearch::improveOrOpt(int a) {
+    const int* list = neighbours + static_cast<size_t>(a) * numNeighbours;
+
+    // Участок s1..s2 длины 1..3, начинающийся с a, переносится к соседу a
+    int s2 = a;
+    for (int length = 1; length <= MaxSegmentLength; ++length) {
+        if (length > 1) {
+            s2 = next(s2);
+        }
+
+        int s1 = a;
+        int p = prev(s1);
+        int after = next(s2);
+        double removed = distance(p, s1) + distance(s2, after) - distance(p, after);
+        if (removed <= Epsilon) {
+            continue;
+        }
+
+        int first = position[s1];
+        auto inSegment = [this, first, length](int vertex) {
+            return (position[vertex] - first + n) % n < length;
+        };
+
+        for (int k = 0; k < numNeighbours; ++k) {
+            int c = list[k];
+            if (std::min(distance(c, s1), distance(s1, c)) >= removed - Epsilon) {
+                break;
+            }
+            if (inSegment(c)) {
+                continue;
+            }
+
+            // c -> s1 ... s2 -> next(c)
+            if (c != p) {
+                int e = next(c);
+                double delta = distance(c, s1) + distance(s2, e) - distance(c, e) - removed;
+                if (delta < -Epsilon) {
+                    moveSegment(first, length, c, false);
+                    activate(p);
+                    activate(after);
+                    activate(c);
+                    activate(e);
+                    activate(s1);
+                    activate(s2);
+                    return delta;
+                }
+            }
+
+            // prev(c) -> s2 ... s1 -> c (участок разворачивается)
+            if (symmetric) {
+                int e = prev(c);
+                if (!inSegment(e)) {
+                    double delta = distance(e, s2) + distance(s1, c) - distance(e, c) - removed;
+                    if (delta < -Epsilon) {
+                        moveSegment(first, length, e, true);
+                        activate(p);
+                        activate(after);
+                        activate(c);
+                        activate(e);
+                        activate(s1);
+                        activate(s2);
+                        return delta;
+                    }
+                }
+            }
+        }
+    }
+
+    return 0.0;
+}
+
+void LocalSearch::reverse(int first, int last) {
+    // Разворот участка кольцевого маршрута; для симметричных расстояний
+    // разворот дополнения даёт тот же маршрут, поэтому разворачивается более короткий
+    int length = (last - first + n) % n + 1;
+    if (2 * length > n) {
+        int complementFirst = (last + 1) % n;
+        last = (first + n - 1) % n;
+        first = complementFirst;
+        length = n - length;
+    }
+
+    for (int k = 0; k < length / 2; ++k) {
+        int u = route[first];
+        int v = route[last];
+        route[first] = v;
+        position[v] = first;
+        route[last] = u;
+        position[u] = last;
+
+        first = (first + 1) % n;
+        last = (last + n - 1) % n;
+    }
+}
+
+void LocalSearch::moveSegment(int first, int length, int after, bool reversed) {
+    int saved[MaxSegmentLength];
+    for (int t = 0; t < length; ++t) {
+        saved[t] = route[(first + t) % n];
+    }
+
+    // Маршрут X Y Z, где X - участок, Y - вершины от следующей за участком
+    // до after, Z - остальные. Результат Y X Z получается сдвигом более короткого из Y и Z.
+    int lengthY = (position[after] - (first + length) + 2 * n) % n + 1;
+    int lengthZ = n - length - lengthY;
+    int target;
+
+    if (lengthY <= lengthZ) {
+        for (int k = 0; k < lengthY; ++k) {
+            int to = (first + k) % n;
+            int vertex = route[(first + length + k) % n];
+            route[to] = vertex;
+            position[vertex] = to;
+        }
+        target = (first + lengthY) % n;
+    } else {
+        int zFirst = (first - lengthZ + n) % n;
+        for (int k = lengthZ - 1; k >= 0; --k) {
+            int to = (zFirst + length + k) % n;
+            int vertex = route[(zFirst + k) % n];
+            route[to] = vertex;
+            position[vertex] = to;
+        }
+        target = zFirst;
+    }
+
+    for (int t = 0; t < length; ++t) {
+        int vertex = reversed ? saved[length - 1 - t] : saved[t];
+        int to = (target + t) % n;
+        route[to] = vertex;
+        position[vertex] = to;
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef LOCALSEARCH_H
+#define LOCALSEARCH_H
+
+#include <vector>
+#include "distancematrix.h"
+
+// Режим локального поиска после построения маршрутов
+enum class LocalSearchMode {
+    None,           // Маршруты муравьёв не улучшаются
+    IterationBest,  // Улучшается только лучший маршрут итерации
+    AllAnts         // Улучшается маршрут каждого муравья
+};
+
+// Виды ходов локального поиска (битовая маска)
+enum LocalSearchMove {
+    LocalSearchTwoOpt = 1,  // Разворот участка маршрута (только симметричные расстояния)
+    LocalSearchOrOpt = 2    // Перенос участка из 1-3 вершин в другое место маршрута
+};
+
+// Улучшение замкнутого маршрута ходами 2-opt и Or-opt.
+// Ходы ищутся только среди ближайших соседей вершины, а вершины без
+// улучшающих ходов помечаются битом "не смотреть" до изменения соседних рёбер.
+// Стоимость посещения входит в маршрут ровно один раз для каждой вершины,
+// поэтому перестановка её не меняет, и приращение хода за O(1) равно
+// изменению суммы рёбер. Объект хранит рабочие массивы между вызовами,
+// поэтому каждому потоку нужен свой экземпляр.
+class LocalSearch {
+public:
+    LocalSearch();
+
+    // Улучшает route на месте и возвращает изменение стоимости (<= 0).
+    // neighbours - списки ближайших соседей по numNeighbours вершин на строку,
+    // упорядоченные по возрастанию расстояния. Первая вершина маршрута сохраняется.
+    double improve(std::vector<int>& route, const DistanceMatrix& distances,
+                   const int* neighbours, int numNeighbours, bool symmetric, int moves);
+
+private:
+    // Поиск и применение улучшающего хода для вершины a; результат - приращение стоимости или 0
+    double improveTwoOpt(int a);
+    double improveOrOpt(int a);
+    void reverse(int first, int last);
+    void moveSegment(int first, int length, int after, bool reversed);
+    void activate(int vertex);
+
+    int next(int vertex) const { return route[(position[vertex] + 1) % n]; }
+    int prev(int vertex) const { return route[(position[vertex] + n - 1) % n]; }
+    double distance(int from, int to) const { return (*distances)(from, to); }
+
+    // Текущая задача
+    int* route;
+    const DistanceMatrix* distances;
+    const int* neighbours;
+    int numNeighbours;
+    int n;
+    bool symmetric;
+
+    // Рабочие массивы (переиспользуются между вызовами)
+    std::vector<int> position;      // Позиция вершины в маршруте
+    std::vector<char> active;       // Вершина в очереди (бит "не смотреть" снят)
+    std::vector<int> queue;         // Кольцевая очередь вершин для проверки
+    int queueHead;
+    int queueSize;
+};
+
+#endif // LOCALSEARCH_H
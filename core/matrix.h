@@ -0,0 +1,182 @@
+#ifndef MATRIX_H
+#define MATRIX_H
+
+#include <vector>
+#include <cstddef>
+#include <new>
+#include <algorithm>
+
+// Аллокатор с выравниванием по границе кэш-линии
+template <typename T, std::size_t Alignment>
+class AlignedAllocator {
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T* p, std::size_t) {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+// Плотная матрица, хранящаяся построчно (row-major) в одном непрерывном блоке.
+// Каждая строка начинается с границы кэш-линии, поэтому цикл по строке
+// читает память последовательно и без разделения строк между линиями.
+template <typename T>
+class Matrix {
+public:
+    using value_type = T;
+
+    static constexpr std::size_t CacheLine = 64;
+    static constexpr bool Symmetric = false;   // (i, j) и (j, i) хранятся отдельно
+
+    Matrix() : numRows(0), numCols(0), rowStride(0) {}
+
+    Matrix(int rows, int cols, T value = T()) : Matrix() {
+        resize(rows, cols, value);
+    }
+
+    // Изменение размера с заполнением всех элементов значением value
+    void resize(int rows, int cols, T value = T()) {
+        const std::size_t perLine = std::max<std::size_t>(1, CacheLine / sizeof(T));
+
+        numRows = rows;
+        numCols = cols;
+        rowStride = (static_cast<std::size_t>(cols) + perLine - 1) / perLine * perLine;
+
+        data.assign(rowStride * static_cast<std::size_t>(rows), value);
+    }
+
+    // Изменение размера с сохранением общей части; новые элементы заполняются value.
+    // Пока шаг строк прежний (столбцы помещаются в выравнивание), строки остаются
+    // на месте и переносятся только при смене шага.
+    void resizePreserving(int rows, int cols, T value = T()) {
+        const std::size_t perLine = std::max<std::size_t>(1, CacheLine / sizeof(T));
+        const std::size_t stride = (static_cast<std::size_t>(cols) + perLine - 1) / perLine * perLine;
+        const int keptRows = std::min(rows, numRows);
+
+        if (stride == rowStride) {
+            for (int i = 0; i < keptRows && cols > numCols; ++i) {
+                std::fill(row(i) + numCols, row(i) + cols, value);
+            }
+            data.resize(stride * static_cast<std::size_t>(rows), value);
+        } else {
+            std::vector<T, AlignedAllocator<T, CacheLine>> resized(stride * static_cast<std::size_t>(rows), value);
+            const int keptCols = std::min(cols, numCols);
+            for (int i = 0; i < keptRows; ++i) {
+                std::copy(row(i), row(i) + keptCols, resized.data() + i * stride);
+            }
+            data.swap(resized);
+        }
+
+        numRows = rows;
+        numCols = cols;
+        rowStride = stride;
+    }
+
+    void fill(T value) {
+        std::fill(data.begin(), data.end(), value);
+    }
+
+    // Указатель на начало строки (выровнен по кэш-линии)
+    T* row(int i) { return data.data() + static_cast<std::size_t>(i) * rowStride; }
+    const T* row(int i) const { return data.data() + static_cast<std::size_t>(i) * rowStride; }
+
+    T& operator()(int i, int j) { return row(i)[j]; }
+    const T& operator()(int i, int j) const { return row(i)[j]; }
+
+    int rows() const { return numRows; }
+    int cols() const { return numCols; }
+    std::size_t stride() const { return rowStride; }
+    bool empty() const { return data.empty(); }
+    std::size_t bytes() const { return data.size() * sizeof(T); }
+
+private:
+    int numRows;              // Количество строк
+    int numCols;              // Количество столбцов
+    std::size_t rowStride;    // Шаг между строками (в элементах)
+    std::vector<T, AlignedAllocator<T, CacheLine>> data;
+};
+
+// Симметричная матрица N x N, в которой хранится только верхний треугольник
+// с диагональю (N * (N + 1) / 2 элементов). Строка i треугольника - элементы
+// (i, i) .. (i, N - 1) - лежит в памяти непрерывно; (i, j) и (j, i) - один элемент.
+template <typename T>
+class SymmetricMatrix {
+public:
+    using value_type = T;
+
+    static constexpr bool Symmetric = true;    // (i, j) и (j, i) - один элемент
+
+    SymmetricMatrix() : numRows(0) {}
+
+    explicit SymmetricMatrix(int n, T value = T()) : SymmetricMatrix() {
+        resize(n, value);
+    }
+
+    void resize(int n, T value = T()) {
+        numRows = n;
+        data.assign(static_cast<std::size_t>(n) * (n + 1) / 2, value);
+    }
+
+    // Изменение размера с сохранением общей части. Смещения строк треугольника
+    // зависят от N, поэтому строки всегда переносятся в новый блок.
+    void resizePreserving(int n, T value = T()) {
+        SymmetricMatrix resized(n, value);
+        const int kept = std::min(n, numRows);
+        for (int i = 0; i < kept; ++i) {
+            std::copy(upperRow(i), upperRow(i) + (kept - i), resized.upperRow(i));
+        }
+
+        numRows = n;
+        data.swap(resized.data);
+    }
+
+    void fill(T value) {
+        std::fill(data.begin(), data.end(), value);
+    }
+
+    // Строка i верхнего треугольника: upperRow(i)[k] - элемент (i, i + k)
+    T* upperRow(int i) { return data.data() + offset(i); }
+    const T* upperRow(int i) const { return data.data() + offset(i); }
+
+    T& operator()(int i, int j) { return data[index(i, j)]; }
+    const T& operator()(int i, int j) const { return data[index(i, j)]; }
+
+    int rows() const { return numRows; }
+    int cols() const { return numRows; }
+    std::size_t size() const { return data.size(); }
+    bool empty() const { return data.empty(); }
+    std::size_t bytes() const { return data.size() * sizeof(T); }
+
+private:
+    // Начало строки i: сумма длин строк 0 .. i - 1
+    std::size_t offset(int i) const {
+        return static_cast<std::size_t>(i) * (2 * static_cast<std::size_t>(numRows) - i + 1) / 2;
+    }
+
+    std::size_t index(int i, int j) const {
+        return i <= j ? offset(i) + (j - i) : offset(j) + (i - j);
+    }
+
+    int numRows;              // Количество строк (и столбцов)
+    std::vector<T, AlignedAllocator<T, Matrix<T>::CacheLine>> data;
+};
+
+#endif // MATRIX_H
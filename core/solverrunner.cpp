@@ -0,0 +1,385 @@
+#include "solverrunner.h"
+#include "tracelog.h"
+
+SolverRunner::SolverRunner(AntColony* colony)
+    : colony(colony), islands(nullptr), pendingCommands(0), hasCommands(false), iterationDelay(0),
+    publishInterval(16), fullMatrixLimit(1000), edgesPerVertex(4),
+    pheromoneViewInterval(100), pheromoneViewDirty(true), checkpointIterations(0), checkpointMilliseconds(0),
+    traceKeyframeInterval(100), tracePheromones(true), statisticsEnabled(false), statisticsHistoryLength(0),
+    running(false), routeVersion(0), lastBestCost(colony->getBestCost()),
+    pheromoneViewVersion(0), collectStatistics(false), historyLength(0)
+{
+    // Начальный снимок доступен сразу после создания
+    publish();
+    thread = std::thread(&SolverRunner::threadLoop, this);
+}
+
+SolverRunner::SolverRunner(IslandModel* islands)
+    : colony(&islands->getIsland(islands->getBestIsland())), islands(islands), pendingCommands(0),
+    hasCommands(false), iterationDelay(0), publishInterval(16), fullMatrixLimit(1000), edgesPerVertex(4),
+    pheromoneViewInterval(100), pheromoneViewDirty(true), checkpointIterations(0), checkpointMilliseconds(0),
+    traceKeyframeInterval(100), tracePheromones(true), statisticsEnabled(false), statisticsHistoryLength(0),
+    running(false), routeVersion(0), lastBestCost(islands->getBestCost()),
+    pheromoneViewVersion(0), collectStatistics(false), historyLength(0)
+{
+    publish();
+    thread = std::thread(&SolverRunner::threadLoop, this);
+}
+
+SolverRunner::~SolverRunner() {
+    post(CommandQuit);
+    thread.join();
+}
+
+void SolverRunner::start() {
+    post(CommandStart);
+}
+
+void SolverRunner::stop() {
+    post(CommandStop);
+}
+
+void SolverRunner::reset() {
+    post(CommandReset);
+}
+
+void SolverRunner::setIterationDelay(int milliseconds) {
+    iterationDelay.store(std::max(0, milliseconds));
+    // Разбудить поток, если он ждёт окончания прежней паузы
+    wakeUp.notify_all();
+}
+
+void SolverRunner::setPheromoneView(int limit, int perVertex) {
+    fullMatrixLimit.store(limit);
+    edgesPerVertex.store(std::max(0, perVertex));
+    pheromoneViewDirty.store(true);
+    post(CommandRefresh);
+}
+
+void SolverRunner::setPheromoneViewInterval(int milliseconds) {
+    pheromoneViewInterval.store(std::max(0, milliseconds));
+}
+
+void SolverRunner::setPublishInterval(int milliseconds) {
+    publishInterval.store(std::max(0, milliseconds));
+}
+
+void SolverRunner::setCheckpoint(const std::string& path, int iterations, int milliseconds) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        checkpointPath = path;
+        checkpointIterations = iterations;
+        checkpointMilliseconds = milliseconds;
+    }
+    post(CommandCheckpoint);
+}
+
+void SolverRunner::applyCheckpointSettings() {
+    std::string path;
+    int iterations, milliseconds;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        path = checkpointPath;
+        iterations = checkpointIterations;
+        milliseconds = checkpointMilliseconds;
+    }
+
+    if (path.empty() || islands) {
+        checkpoints.reset();
+        return;
+    }
+    if (!checkpoints || checkpoints->getPath() != path) {
+        checkpoints.reset(new CheckpointWriter(path));
+    }
+    checkpoints->setInterval(iterations, milliseconds);
+}
+
+void SolverRunner::setTrace(const std::string& path, int keyframeInterval, bool pheromones) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tracePath = path;
+        traceKeyframeInterval = keyframeInterval;
+        tracePheromones = pheromones;
+    }
+    post(CommandTrace);
+}
+
+void SolverRunner::applyTraceSettings() {
+    std::string path;
+    int keyframeInterval;
+    bool pheromones;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        path = tracePath;
+        keyframeInterval = traceKeyframeInterval;
+        pheromones = tracePheromones;
+    }
+
+    if (path.empty()) {
+        trace.reset();
+        return;
+    }
+
+    // Новый файл с текущей итерации; при ошибке запись отключается
+    std::string error;
+    trace.reset(new TraceRecorder());
+    if (!trace->open(path, *colony, keyframeInterval, pheromones, error)) {
+        trace.reset();
+    }
+}
+
+void SolverRunner::setStatistics(bool enabled, int historyLength) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        statisticsEnabled = enabled;
+        statisticsHistoryLength = std::max(1, historyLength);
+    }
+    post(CommandStatistics);
+}
+
+void SolverRunner::applyStatisticsSettings() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        collectStatistics = statisticsEnabled;
+        historyLength = static_cast<std::size_t>(statisticsHistoryLength);
+    }
+
+    int count = islands ? islands->getIslandCount() : 1;
+    for (int i = 0; i < count; ++i) {
+        (islands ? islands->getIsland(i) : *colony).setStatisticsEnabled(collectStatistics);
+    }
+
+    if (!collectStatistics) {
+        statisticsHistory.clear();
+    }
+    while (statisticsHistory.size() > historyLength) {
+        statisticsHistory.pop_front();
+    }
+}
+
+void SolverRunner::post(int command) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // Команды применяются в порядке сброс, остановка, запуск, поэтому запуск,
+        // отправленный до остановки или сброса, отменяется, а после них - сохраняется
+        if (command & (CommandStop | CommandReset)) {
+            pendingCommands &= ~CommandStart;
+        }
+        pendingCommands |= command;
+        hasCommands.store(true, std::memory_order_release);
+    }
+    wakeUp.notify_all();
+}
+
+void SolverRunner::threadLoop() {
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point lastPublish = Clock::now();
+
+    while (true) {
+        // Обработка команд (и ожидание, пока решатель остановлен)
+        int commands = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (!running) {
+                wakeUp.wait(lock, [this]() { return pendingCommands != 0; });
+            }
+            commands = pendingCommands;
+            pendingCommands = 0;
+            hasCommands.store(false, std::memory_order_relaxed);
+        }
+
+        if (commands & CommandQuit) {
+            return;
+        }
+
+        if (commands & CommandCheckpoint) {
+            applyCheckpointSettings();
+        }
+        if (commands & CommandTrace) {
+            applyTraceSettings();
+        }
+        if (commands & CommandStatistics) {
+            applyStatisticsSettings();
+        }
+
+        bool changed = (commands & (CommandRefresh | CommandStatistics)) != 0;
+        if (commands & CommandReset) {
+            resetSolver();
+            running = false;
+            statisticsHistory.clear();
+            if (trace) {
+                applyTraceSettings();
+            }
+            changed = true;
+        }
+        if (commands & CommandStop) {
+            // Остановка сохраняет состояние: следующий запуск (или процесс) продолжит с него
+            if (checkpoints && running) {
+                checkpoints->save(*colony);
+            }
+            running = false;
+            changed = true;
+        }
+        if (commands & CommandStart) {
+            running = !isSolverFinished();
+            changed = true;
+        }
+
+        if (changed) {
+            publish();
+            lastPublish = Clock::now();
+        }
+
+        // Итерации до следующей команды
+        while (running && !hasCommands.load(std::memory_order_acquire)) {
+            runSolverIteration();
+            if (trace) {
+                trace->record(*colony);
+            }
+            if (collectStatistics) {
+                statisticsHistory.push_back(colony->getLastStatistics());
+                if (statisticsHistory.size() > historyLength) {
+                    statisticsHistory.pop_front();
+                }
+            }
+
+            if (isSolverFinished()) {
+                running = false;
+                if (checkpoints) {
+                    checkpoints->save(*colony);
+                }
+            } else if (checkpoints) {
+                checkpoints->onIteration(*colony);
+            }
+
+            Clock::time_point now = Clock::now();
+            int delay = iterationDelay.load();
+            if (!running || delay > 0 ||
+                now - lastPublish >= std::chrono::milliseconds(publishInterval.load())) {
+                publish();
+                lastPublish = now;
+            }
+
+            if (running && delay > 0) {
+                std::unique_lock<std::mutex> lock(mutex);
+                wakeUp.wait_for(lock, std::chrono::milliseconds(delay), [this]() {
+                    return pendingCommands != 0 || iterationDelay.load() == 0;
+                });
+            }
+        }
+    }
+}
+
+void SolverRunner::resetSolver() {
+    if (islands) {
+        islands->reset();
+        colony = &islands->getIsland(islands->getBestIsland());
+    } else {
+        colony->reset();
+    }
+}
+
+void SolverRunner::runSolverIteration() {
+    if (islands) {
+        islands->runIteration();
+        colony = &islands->getIsland(islands->getBestIsland());
+    } else {
+        colony->runIteration();
+    }
+}
+
+bool SolverRunner::isSolverFinished() const {
+    return islands ? islands->isFinished() : colony->isFinished();
+}
+
+void SolverRunner::publish() {
+    ColonySnapshot& target = snapshots.writeBuffer();
+
+    if (colony->getBestCost() != lastBestCost) {
+        lastBestCost = colony->getBestCost();
+        ++routeVersion;
+    }
+
+    target.iteration = colony->getCurrentIteration();
+    target.maxIterations = colony->getMaxIterations();
+    target.bestCost = colony->getBestCost();
+    target.bestRoute.assign(colony->getBestRoute().begin(), colony->getBestRoute().end());
+    target.routeVersion = routeVersion;
+    target.running = running;
+    target.finished = isSolverFinished();
+    target.termination = islands ? islands->getTerminationReason() : colony->getTerminationReason();
+    target.restarts = 0;
+    int count = islands ? islands->getIslandCount() : 1;
+    for (int i = 0; i < count; ++i) {
+        target.restarts += (islands ? islands->getIsland(i) : *colony).getRestartCount();
+    }
+    target.island = islands ? islands->getBestIsland() : -1;
+
+    // Представление феромонов перестраивается с ограниченной частотой,
+    // а при остановке - всегда, чтобы на экране было итоговое состояние
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (!pheromoneView || !running || pheromoneViewDirty.exchange(false) ||
+        now - pheromoneViewTime >= std::chrono::milliseconds(pheromoneViewInterval.load())) {
+        pheromoneView = buildPheromoneView();
+        pheromoneViewTime = now;
+    }
+    target.pheromoneView = pheromoneView;
+    target.statistics.assign(statisticsHistory.begin(), statisticsHistory.end());
+
+    snapshots.publish();
+}
+
+std::shared_ptr<const PheromoneView> SolverRunner::buildPheromoneView() {
+    auto view = std::make_shared<PheromoneView>();
+    view->version = ++pheromoneViewVersion;
+
+    const int n = colony->getNumVertices();
+    const int limit = fullMatrixLimit.load();
+
+    if (n <= limit) {
+        // Полная матрица
+        view->vertices = n;
+        view->matrix.resize(static_cast<size_t>(n) * n);
+
+        for (int i = 0; i < n; ++i) {
+            float* row = view->matrix.data() + static_cast<size_t>(i) * n;
+            for (int j = 0; j < n; ++j) {
+                row[j] = static_cast<float>(colony->getPheromone(i, j));
+                view->maxPheromone = std::max(view->maxPheromone, row[j]);
+            }
+        }
+        return view;
+    }
+
+    // Прореженный вид: k рёбер с наибольшим феромоном для каждой вершины.
+    // Со списками кандидатов выбор идёт среди кандидатов, иначе - по всей строке.
+    const int k = std::min(edgesPerVertex.load(), n - 1);
+    const int numCandidates = colony->getCandidateListSize();
+    view->topEdges.reserve(static_cast<size_t>(n) * std::max(k, 0));
+
+    std::vector<SnapshotEdge> row;
+    auto stronger = [](const SnapshotEdge& a, const SnapshotEdge& b) { return a.pheromone > b.pheromone; };
+
+    for (int i = 0; i < n && k > 0; ++i) {
+        row.clear();
+
+        if (numCandidates >= k) {
+            const int* candidateRow = colony->getCandidates(i);
+            for (int c = 0; c < numCandidates; ++c) {
+                row.push_back({ i, candidateRow[c], static_cast<float>(colony->getPheromone(i, candidateRow[c])) });
+            }
+        } else {
+            for (int j = 0; j < n; ++j) {
+                if (j != i) {
+                    row.push_back({ i, j, static_cast<float>(colony->getPheromone(i, j)) });
+                }
+            }
+        }
+
+        std::partial_sort(row.begin(), row.begin() + k, row.end(), stronger);
+        view->topEdges.insert(view->topEdges.end(), row.begin(), row.begin() + k);
+        view->maxPheromone = std::max(view->maxPheromone, row.front().pheromone);
+    }
+
+    return view;
+}
@@ -0,0 +1,168 @@
+#ifndef SOLVERRUNNER_H
+#define SOLVERRUNNER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "antcolony.h"
+#include "checkpoint.h"
+#include "islandmodel.h"
+#include "triplebuffer.h"
+
+class TraceRecorder;
+
+// Ребро в прореженном представлении феромонов
+struct SnapshotEdge {
+    int from;
+    int to;
+    float pheromone;
+};
+
+// Представление феромонов для отображения: полная матрица N x N
+// (vertices = N), если N не больше лимита, иначе - несколько рёбер
+// с наибольшим феромоном для каждой вершины. После публикации не меняется.
+struct PheromoneView {
+    int vertices = 0;
+    std::vector<float> matrix;
+    std::vector<SnapshotEdge> topEdges;
+    float maxPheromone = 0.0f;
+    unsigned long long version = 0;    // Растёт при каждом обновлении
+};
+
+// Снимок состояния колонии для отображения
+struct ColonySnapshot {
+    int iteration = 0;                 // Текущая итерация
+    int maxIterations = 0;             // Максимальное количество итераций
+    double bestCost = std::numeric_limits<double>::max();
+    std::vector<int> bestRoute;        // Лучший маршрут
+    unsigned long long routeVersion = 0; // Меняется при каждом изменении лучшего маршрута
+    bool running = false;              // Решатель выполняет итерации
+    bool finished = false;             // Решатель завершён (maxIterations или условие завершения)
+    TerminationReason termination = TerminationReason::None;
+    int restarts = 0;                  // Перезапусков феромона при застое (всех островов)
+    int island = -1;                   // Остров лучшего маршрута (-1 без островной модели)
+
+    // Феромоны (обновляются не чаще setPheromoneViewInterval и разделяются между снимками)
+    std::shared_ptr<const PheromoneView> pheromoneView;
+
+    // Статистика последних итераций по порядку (пусто, если сбор выключен)
+    std::vector<IterationStatistics> statistics;
+};
+
+// Выполнение итераций колонии в отдельном потоке.
+// Команды start/stop/reset потокобезопасны и применяются между итерациями;
+// состояние публикуется снимками через TripleBuffer, поэтому поток
+// интерфейса читает его без блокировок и без обращения к колонии.
+class SolverRunner {
+public:
+    // Колония должна существовать дольше SolverRunner и не использоваться другими потоками
+    explicit SolverRunner(AntColony* colony);
+
+    // Островная модель: итерации выполняются на всех островах, а снимок
+    // (лучший маршрут и феромоны) берётся с острова с лучшим маршрутом
+    explicit SolverRunner(IslandModel* islands);
+    ~SolverRunner();
+
+    SolverRunner(const SolverRunner&) = delete;
+    SolverRunner& operator=(const SolverRunner&) = delete;
+
+    void start();
+    void stop();
+    void reset();
+
+    // Пауза между итерациями (0 - максимальная скорость)
+    void setIterationDelay(int milliseconds);
+
+    // Максимальное N для передачи полной матрицы феромонов и число рёбер на вершину иначе
+    void setPheromoneView(int fullMatrixLimit, int edgesPerVertex);
+
+    // Минимальный интервал между обновлениями представления феромонов
+    void setPheromoneViewInterval(int milliseconds);
+
+    // Минимальный интервал между снимками при непрерывной работе
+    void setPublishInterval(int milliseconds);
+
+    // Контрольные точки: каждые iterations итераций или milliseconds мс (0 - не
+    // использовать), а также при остановке и завершении. Пустой путь отключает.
+    // Островная модель контрольные точки не сохраняет.
+    void setCheckpoint(const std::string& path, int iterations, int milliseconds);
+
+    // Запись трассы прогона (TraceRecorder): ключевой кадр каждые keyframeInterval
+    // итераций, с феромонами или без. Сброс начинает файл заново. Пустой путь отключает.
+    void setTrace(const std::string& path, int keyframeInterval, bool pheromones);
+
+    // Сбор статистики итераций (с островами - острова с лучшим маршрутом). Снимок
+    // содержит статистику не более historyLength последних итераций.
+    void setStatistics(bool enabled, int historyLength = 500);
+
+    // Для потока-читателя: получение нового снимка; false, если новых нет
+    bool poll() { return snapshots.update(); }
+    const ColonySnapshot& snapshot() const { return snapshots.readBuffer(); }
+
+private:
+    enum Command {
+        CommandStart = 1,
+        CommandStop = 2,
+        CommandReset = 4,
+        CommandQuit = 8,
+        CommandRefresh = 16,    // Опубликовать снимок с новым представлением феромонов
+        CommandCheckpoint = 32, // Применить настройки контрольных точек
+        CommandTrace = 64,      // Применить настройки записи трассы
+        CommandStatistics = 128 // Применить настройки сбора статистики
+    };
+
+    void post(int command);
+    void threadLoop();
+    void publish();
+    void resetSolver();
+    void runSolverIteration();
+    bool isSolverFinished() const;
+    void applyCheckpointSettings();
+    void applyTraceSettings();
+    void applyStatisticsSettings();
+    std::shared_ptr<const PheromoneView> buildPheromoneView();
+
+    AntColony* colony;                   // Колония (с островами - остров с лучшим маршрутом)
+    IslandModel* islands;                // nullptr без островной модели
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    int pendingCommands;                 // Под mutex
+    std::atomic<bool> hasCommands;       // Быстрая проверка между итерациями
+    std::atomic<int> iterationDelay;
+    std::atomic<int> publishInterval;
+    std::atomic<int> fullMatrixLimit;
+    std::atomic<int> edgesPerVertex;
+    std::atomic<int> pheromoneViewInterval;
+    std::atomic<bool> pheromoneViewDirty;  // Параметры представления изменились
+    std::string checkpointPath;          // Под mutex
+    int checkpointIterations;            // Под mutex
+    int checkpointMilliseconds;          // Под mutex
+    std::string tracePath;               // Под mutex
+    int traceKeyframeInterval;           // Под mutex
+    bool tracePheromones;                // Под mutex
+    bool statisticsEnabled;              // Под mutex
+    int statisticsHistoryLength;         // Под mutex
+
+    // Состояние потока решателя
+    bool running;
+    unsigned long long routeVersion;
+    double lastBestCost;
+    std::shared_ptr<const PheromoneView> pheromoneView;
+    std::chrono::steady_clock::time_point pheromoneViewTime;
+    unsigned long long pheromoneViewVersion;
+    std::unique_ptr<CheckpointWriter> checkpoints;
+    std::unique_ptr<TraceRecorder> trace;
+    bool collectStatistics;
+    std::size_t historyLength;
+    std::deque<IterationStatistics> statisticsHistory;
+
+    TripleBuffer<ColonySnapshot> snapshots;
+};
+
+#endif // SOLVERRUNNER_H
@@ -0,0 +1,55 @@
+#include "statisticslog.h"
+
+StatisticsLog::~StatisticsLog() {
+    close();
+}
+
+bool StatisticsLog::open(const std::string& path, std::string& error) {
+    bool csv = path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+    return open(path, csv ? StatisticsFormat::Csv : StatisticsFormat::JsonLines, error);
+}
+
+bool StatisticsLog::open(const std::string& path, StatisticsFormat logFormat, std::string& error) {
+    close();
+
+    file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        error = "cannot create " + path;
+        return false;
+    }
+
+    format = logFormat;
+    if (format == StatisticsFormat::Csv) {
+        std::fputs("island,iteration,iteration_s,construction_s,local_search_s,evaporation_s,deposit_s,"
+                   "choice_info_s,steps_per_s,allocations,branching,entropy,mean_cost,min_cost,max_cost,best_cost\n",
+                   file);
+    }
+    return true;
+}
+
+void StatisticsLog::close() {
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+void StatisticsLog::write(const IterationStatistics& s, int island) {
+    if (!file) return;
+
+    if (format == StatisticsFormat::Csv) {
+        std::fprintf(file, "%d,%d,%.9f,%.9f,%.9f,%.9f,%.9f,%.9f,%.1f,%lld,%.4f,%.6f,%.6f,%.6f,%.6f,%.6f\n",
+                     island, s.iteration, s.iterationSeconds, s.constructionSeconds, s.localSearchSeconds,
+                     s.evaporationSeconds, s.depositSeconds, s.choiceInfoSeconds, s.stepsPerSecond,
+                     s.allocations, s.branchingFactor, s.entropy, s.meanCost, s.minCost, s.maxCost, s.bestCost);
+    } else {
+        std::fprintf(file,
+                     "{\"island\":%d,\"iteration\":%d,\"iteration_s\":%.9f,\"construction_s\":%.9f,"
+                     "\"local_search_s\":%.9f,\"evaporation_s\":%.9f,\"deposit_s\":%.9f,\"choice_info_s\":%.9f,"
+                     "\"steps_per_s\":%.1f,\"allocations\":%lld,\"branching\":%.4f,\"entropy\":%.6f,"
+                     "\"mean_cost\":%.6f,\"min_cost\":%.6f,\"max_cost\":%.6f,\"best_cost\":%.6f}\n",
+                     island, s.iteration, s.iterationSeconds, s.constructionSeconds, s.localSearchSeconds,
+                     s.evaporationSeconds, s.depositSeconds, s.choiceInfoSeconds, s.stepsPerSecond,
+                     s.allocations, s.branchingFactor, s.entropy, s.meanCost, s.minCost, s.maxCost, s.bestCost);
+    }
+}
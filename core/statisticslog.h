@@ -0,0 +1,38 @@
+#ifndef STATISTICSLOG_H
+#define STATISTICSLOG_H
+
+#include <cstdio>
+#include <string>
+#include "antcolony.h"
+
+// Формат журнала статистики
+enum class StatisticsFormat {
+    Csv,        // Заголовок и строка значений через запятую на итерацию
+    JsonLines   // Объект JSON на итерацию
+};
+
+// Журнал статистики итераций (IterationStatistics) для запусков без интерфейса.
+// Строки пишутся в буфер файла по мере работы и не выделяют память.
+class StatisticsLog {
+public:
+    StatisticsLog() = default;
+    ~StatisticsLog();
+
+    StatisticsLog(const StatisticsLog&) = delete;
+    StatisticsLog& operator=(const StatisticsLog&) = delete;
+
+    // Формат по расширению: .csv - CSV, иначе JSON Lines. Файл перезаписывается.
+    bool open(const std::string& path, std::string& error);
+    bool open(const std::string& path, StatisticsFormat format, std::string& error);
+    void close();
+    bool isOpen() const { return file != nullptr; }
+
+    // Запись итерации острова island (0 для одной колонии)
+    void write(const IterationStatistics& statistics, int island = 0);
+
+private:
+    std::FILE* file = nullptr;
+    StatisticsFormat format = StatisticsFormat::JsonLines;
+};
+
+#endif // STATISTICSLOG_H
@@ -0,0 +1,77 @@
+#include "termination.h"
+
+const char* terminationReasonName(TerminationReason reason) {
+    switch (reason) {
+    case TerminationReason::IterationLimit: return "iteration limit";
+    case TerminationReason::TimeLimit: return "time limit";
+    case TerminationReason::TargetCost: return "target cost";
+    case TerminationReason::NoImprovement: return "no improvement";
+    default: return "none";
+    }
+}
+
+void TerminationMonitor::reset() {
+    reason = TerminationReason::None;
+    started = false;
+    iterationsRun = 0;
+    iterationsSinceImprovement = 0;
+    lastBestCost = std::numeric_limits<double>::max();
+}
+
+void TerminationMonitor::beginIteration() {
+    if (!started) {
+        started = true;
+        startTime = improvementTime = Clock::now();
+        iterationsRun = 0;
+        iterationsSinceImprovement = 0;
+        lastBestCost = std::numeric_limits<double>::max();
+    }
+}
+
+TerminationReason TerminationMonitor::endIteration(int iteration, int maxIterations, double bestCost) {
+    Clock::time_point now = Clock::now();
+    ++iterationsRun;
+
+    if (bestCost < lastBestCost) {
+        lastBestCost = bestCost;
+        improvementTime = now;
+        iterationsSinceImprovement = 0;
+    } else {
+        ++iterationsSinceImprovement;
+    }
+
+    // Лимит времени: следующая итерация средней длительности не должна выйти за лимит
+    double elapsedMs = std::chrono::duration<double, std::milli>(now - startTime).count();
+    double stallMs = std::chrono::duration<double, std::milli>(now - improvementTime).count();
+
+    if (criteria.targetCost > 0.0 && bestCost <= criteria.targetCost) {
+        reason = TerminationReason::TargetCost;
+    } else if (iteration >= maxIterations) {
+        reason = TerminationReason::IterationLimit;
+    } else if (criteria.timeLimitMs > 0 && elapsedMs + elapsedMs / iterationsRun > criteria.timeLimitMs) {
+        reason = TerminationReason::TimeLimit;
+    } else if ((criteria.stallIterations > 0 && iterationsSinceImprovement >= criteria.stallIterations) ||
+               (criteria.stallMs > 0 && stallMs >= criteria.stallMs)) {
+        reason = TerminationReason::NoImprovement;
+    }
+    return reason;
+}
+
+void TerminationMonitor::restartImprovement(double bestCost) {
+    if (reason == TerminationReason::NoImprovement || reason == TerminationReason::TargetCost) {
+        reason = TerminationReason::None;
+    }
+    lastBestCost = bestCost;
+    iterationsSinceImprovement = 0;
+    improvementTime = Clock::now();
+}
+
+void TerminationMonitor::clearIterationLimit() {
+    if (reason == TerminationReason::IterationLimit) {
+        reason = TerminationReason::None;
+    }
+}
+
+double TerminationMonitor::getElapsedSeconds() const {
+    return started ? std::chrono::duration<double>(Clock::now() - startTime).count() : 0.0;
+}
@@ -0,0 +1,69 @@
+#ifndef TERMINATION_H
+#define TERMINATION_H
+
+#include <chrono>
+#include <limits>
+
+// Причина завершения работы решателя
+enum class TerminationReason {
+    None,               // Решатель не завершён
+    IterationLimit,     // Выполнено maxIterations итераций
+    TimeLimit,          // Исчерпан лимит времени
+    TargetCost,         // Найден маршрут не дороже целевой стоимости
+    NoImprovement       // Лучший маршрут не улучшался заданное число итераций или время
+};
+
+// Условия досрочного завершения (0 - условие не используется). Время считается
+// от начала первой итерации после сброса; условия проверяются между итерациями.
+struct TerminationCriteria {
+    int timeLimitMs = 0;        // Лимит времени работы
+    double targetCost = 0.0;    // Целевая стоимость (например, оптимум * (1 + допустимый разрыв))
+    int stallIterations = 0;    // Итераций без улучшения лучшего маршрута
+    int stallMs = 0;            // Миллисекунд без улучшения лучшего маршрута
+};
+
+// Короткое название причины для вывода ("time limit", "target cost" и т. п.)
+const char* terminationReasonName(TerminationReason reason);
+
+// Проверка условий завершения для колонии или островной модели.
+// Вызывающий код отмечает начало итерации (beginIteration) и после неё
+// передаёт номер итерации и лучшую стоимость (endIteration).
+class TerminationMonitor {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    void setCriteria(const TerminationCriteria& value) { criteria = value; }
+    const TerminationCriteria& getCriteria() const { return criteria; }
+
+    // Сброс причины и часов (следующая итерация начинает отсчёт заново)
+    void reset();
+
+    void beginIteration();
+
+    // Проверка после итерации; возвращает причину завершения или None
+    TerminationReason endIteration(int iteration, int maxIterations, double bestCost);
+
+    // Задача изменилась: застой отсчитывается заново от bestCost, а завершение
+    // по застою или целевой стоимости снимается (лимиты итераций и времени остаются)
+    void restartImprovement(double bestCost);
+
+    // Лимит итераций увеличен: завершение по лимиту итераций снимается
+    void clearIterationLimit();
+
+    TerminationReason getReason() const { return reason; }
+
+    // Время с начала первой итерации
+    double getElapsedSeconds() const;
+
+private:
+    TerminationCriteria criteria;
+    TerminationReason reason = TerminationReason::None;
+    bool started = false;
+    Clock::time_point startTime;
+    Clock::time_point improvementTime;    // Последнее улучшение лучшего маршрута
+    int iterationsRun = 0;                // Итераций с начала отсчёта
+    int iterationsSinceImprovement = 0;
+    double lastBestCost = std::numeric_limits<double>::max();
+};
+
+#endif // TERMINATION_H
@@ -0,0 +1,72 @@
+#include "threadpool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(int numThreads)
+    : numThreads(std::max(1, numThreads)), task(nullptr), generation(0),
+    pending(0), stopping(false)
+{
+    threads.reserve(this->numThreads - 1);
+    for (int worker = 1; worker < this->numThreads; ++worker) {
+        threads.emplace_back(&ThreadPool::workerLoop, this, worker);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    taskReady.notify_all();
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::run(const std::function<void(int)>& job) {
+    if (numThreads == 1) {
+        job(0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        task = &job;
+        pending = numThreads - 1;
+        ++generation;
+    }
+    taskReady.notify_all();
+
+    // Вызывающий поток выполняет свою часть работы
+    job(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    taskDone.wait(lock, [this]() { return pending == 0; });
+    task = nullptr;
+}
+
+void ThreadPool::workerLoop(int worker) {
+    unsigned long long seen = 0;
+
+    while (true) {
+        const std::function<void(int)>* job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            taskReady.wait(lock, [&]() { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+            job = task;
+        }
+
+        (*job)(worker);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0) {
+                taskDone.notify_one();
+            }
+        }
+    }
+}
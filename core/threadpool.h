@@ -0,0 +1,46 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+// Фиксированный пул рабочих потоков.
+// run() выполняет задачу на каждом потоке пула (вызывающий поток работает
+// как поток 0) и возвращает управление после завершения всех потоков.
+class ThreadPool {
+public:
+    explicit ThreadPool(int numThreads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const { return numThreads; }
+
+    // Выполнение task(worker) для worker = 0 .. size() - 1
+    void run(const std::function<void(int)>& task);
+
+    // Разбиение диапазона [0, count) на равные блоки по потокам
+    static void splitRange(int count, int parts, int part, int& begin, int& end) {
+        begin = static_cast<int>(static_cast<long long>(count) * part / parts);
+        end = static_cast<int>(static_cast<long long>(count) * (part + 1) / parts);
+    }
+
+private:
+    void workerLoop(int worker);
+
+    int numThreads;                              // Количество потоков (включая вызывающий)
+    std::vector<std::thread> threads;            // Дополнительные потоки
+    std::mutex mutex;
+    std::condition_variable taskReady;
+    std::condition_variable taskDone;
+    const std::function<void(int)>* task;        // Текущая задача
+    unsigned long long generation;               // Номер текущей задачи
+    int pending;                                 // Потоки, ещё не завершившие задачу
+    bool stopping;
+};
+
+#endif // THREADPOOL_H
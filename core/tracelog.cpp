@@ -0,0 +1,447 @@
+#include "tracelog.h"
+#include "antcolony.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+const char TraceMagic[8] = { 'A', 'C', 'O', 'T', 'R', 'A', 'C', 'E' };
+
+// Буфер записи файла трассы
+const std::size_t TraceFileBuffer = 1 << 20;
+
+// Уровни квантования феромона (8 бит)
+const int PheromoneLevels = 255;
+
+// Лучший маршрут, начинающийся с вершины 0 (пустой, если маршрута нет)
+void normalizedRoute(const std::vector<int>& route, std::vector<int>& out) {
+    out.clear();
+    auto start = std::find(route.begin(), route.end(), 0);
+    if (start == route.end()) {
+        return;
+    }
+    out.insert(out.end(), start, route.end());
+    out.insert(out.end(), route.begin(), start);
+}
+
+// Чтение значения из отображённого файла (записи не выровнены)
+template <typename T>
+T readValue(const char* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+// Данные записи содержат всё, что читает декодер: номер итерации, длину маршрута
+// или число участков, стоимость, затем маршрут и феромоны кадра или участки итерации
+bool isRecordValid(const TraceHeader& header, const TraceRecordHeader& record, const char* data) {
+    const std::size_t fixed = 2 * sizeof(std::int32_t) + sizeof(double);
+    if (record.size < fixed || (record.type != TraceKeyframe && record.type != TraceIteration)) {
+        return false;
+    }
+
+    const std::size_t n = static_cast<std::size_t>(header.numVertices);
+    const std::int32_t count = readValue<std::int32_t>(data + sizeof(std::int32_t));
+    if (count < 0) {
+        return false;
+    }
+
+    if (record.type == TraceKeyframe) {
+        if (static_cast<std::size_t>(count) > n) {
+            return false;
+        }
+        std::size_t expected = fixed + static_cast<std::size_t>(count) * sizeof(std::int32_t);
+        if (header.pheromones) {
+            expected += 2 * sizeof(double) + (header.triangle ? n * (n - 1) / 2 : n * (n - 1));
+        }
+        return record.size >= expected;
+    }
+
+    // Участки итерации: начало и длина, затем вершины участка
+    std::size_t offset = fixed;
+    for (std::int32_t r = 0; r < count; ++r) {
+        if (record.size - offset < 2 * sizeof(std::int32_t)) {
+            return false;
+        }
+        std::int32_t length = readValue<std::int32_t>(data + offset + sizeof(std::int32_t));
+        offset += 2 * sizeof(std::int32_t);
+        if (length < 0 || static_cast<std::size_t>(length) > (record.size - offset) / sizeof(std::int32_t)) {
+            return false;
+        }
+        offset += static_cast<std::size_t>(length) * sizeof(std::int32_t);
+    }
+    return true;
+}
+
+} // namespace
+
+TraceRecorder::~TraceRecorder() {
+    close();
+}
+
+bool TraceRecorder::open(const std::string& path, const AntColony& colony, int interval,
+                         bool withPheromones, std::string& error) {
+    close();
+
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        error = "cannot create " + path;
+        return false;
+    }
+    std::setvbuf(file, nullptr, _IOFBF, TraceFileBuffer);
+
+    numVertices = colony.getNumVertices();
+    keyframeInterval = std::max(1, interval);
+    pheromones = withPheromones;
+    triangle = colony.isCompactStorage();
+    hasRecords = false;
+    previousRoute.clear();
+
+    TraceHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, TraceMagic, sizeof(header.magic));
+    header.version = TraceVersion;
+    header.headerSize = sizeof(TraceHeader);
+    header.numVertices = numVertices;
+    header.keyframeInterval = keyframeInterval;
+    header.pheromones = pheromones;
+    header.triangle = triangle;
+    std::fwrite(&header, sizeof(header), 1, file);
+
+    for (const Vertex& vertex : colony.getVertices()) {
+        const double fields[3] = { vertex.position.x, vertex.position.y, vertex.visitCost };
+        std::fwrite(fields, sizeof(fields), 1, file);
+    }
+
+    if (std::ferror(file)) {
+        error = "cannot write " + path;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void TraceRecorder::close() {
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+template <typename T>
+void TraceRecorder::append(const T& value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    payload.insert(payload.end(), bytes, bytes + sizeof(T));
+}
+
+void TraceRecorder::writeRecord(std::uint32_t type) {
+    TraceRecordHeader header = { type, static_cast<std::uint32_t>(payload.size()) };
+    std::fwrite(&header, sizeof(header), 1, file);
+    std::fwrite(payload.data(), 1, payload.size(), file);
+}
+
+void TraceRecorder::record(const AntColony& colony) {
+    if (!file || colony.getNumVertices() != numVertices) {
+        return;
+    }
+
+    normalizedRoute(colony.getBestRoute(), currentRoute);
+    payload.clear();
+
+    // Первая запись и каждая keyframeInterval-я итерация - ключевой кадр
+    if (!hasRecords || colony.getCurrentIteration() % keyframeInterval == 0) {
+        writeKeyframe(colony);
+    } else {
+        // Изменения маршрута - непрерывные участки позиций с новыми вершинами
+        std::int32_t runs = 0;
+        append(static_cast<std::int32_t>(colony.getCurrentIteration()));
+        append(runs);
+        append(colony.getBestCost());
+
+        bool resized = currentRoute.size() != previousRoute.size();
+        int length = static_cast<int>(currentRoute.size());
+        for (int i = 0; i < length;) {
+            if (!resized && currentRoute[i] == previousRoute[i]) {
+                ++i;
+                continue;
+            }
+
+            int end = i + 1;
+            while (end < length && (resized || currentRoute[end] != previousRoute[end])) {
+                ++end;
+            }
+            append(static_cast<std::int32_t>(i));
+            append(static_cast<std::int32_t>(end - i));
+            for (int k = i; k < end; ++k) {
+                append(static_cast<std::int32_t>(currentRoute[k]));
+            }
+            ++runs;
+            i = end;
+        }
+
+        std::memcpy(payload.data() + sizeof(std::int32_t), &runs, sizeof(runs));
+        writeRecord(TraceIteration);
+    }
+
+    previousRoute.swap(currentRoute);
+    hasRecords = true;
+}
+
+void TraceRecorder::writeKeyframe(const AntColony& colony) {
+    append(static_cast<std::int32_t>(colony.getCurrentIteration()));
+    append(static_cast<std::int32_t>(currentRoute.size()));
+    append(colony.getBestCost());
+    for (int vertex : currentRoute) {
+        append(static_cast<std::int32_t>(vertex));
+    }
+
+    if (pheromones) {
+        // Логарифмическая шкала между наименьшим и наибольшим феромоном
+        // (вне диагонали): границы MMAS и испарение различаются на порядки
+        double low = std::numeric_limits<double>::max();
+        double high = 0.0;
+        for (int i = 0; i < numVertices; ++i) {
+            for (int j = triangle ? i + 1 : 0; j < numVertices; ++j) {
+                if (i != j) {
+                    double value = colony.getPheromone(i, j);
+                    if (value > 0.0) {
+                        low = std::min(low, value);
+                    }
+                    high = std::max(high, value);
+                }
+            }
+        }
+
+        double logLow = high > 0.0 ? std::log(low) : 0.0;
+        double logHigh = high > 0.0 ? std::log(high) : 0.0;
+        double scale = logHigh > logLow ? PheromoneLevels / (logHigh - logLow) : 0.0;
+        append(logLow);
+        append(logHigh);
+
+        for (int i = 0; i < numVertices; ++i) {
+            for (int j = triangle ? i + 1 : 0; j < numVertices; ++j) {
+                if (i != j) {
+                    double value = colony.getPheromone(i, j);
+                    double level = value > 0.0 ? (std::log(value) - logLow) * scale : 0.0;
+                    payload.push_back(static_cast<char>(static_cast<std::uint8_t>(
+                        std::min(std::max(std::lround(level), 0L), static_cast<long>(PheromoneLevels)))));
+                }
+            }
+        }
+    }
+
+    writeRecord(TraceKeyframe);
+}
+
+bool TraceReader::open(const std::string& path, std::string& error) {
+    records.clear();
+    keyframes.clear();
+    vertices.clear();
+    decoded = false;
+    pheromoneView.reset();
+
+    if (!file.open(path)) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    const char* data = file.data();
+    const std::size_t size = file.size();
+    if (size < sizeof(TraceHeader)) {
+        error = "truncated trace header";
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+
+    if (std::memcmp(header.magic, TraceMagic, sizeof(header.magic)) != 0) {
+        error = "not a trace file";
+        return false;
+    }
+    if (header.version != TraceVersion || header.headerSize != sizeof(TraceHeader)) {
+        error = "unsupported trace version " + std::to_string(header.version);
+        return false;
+    }
+
+    const int n = header.numVertices;
+    std::size_t offset = sizeof(TraceHeader) + static_cast<std::size_t>(std::max(n, 0)) * 3 * sizeof(double);
+    if (n < 2 || offset > size) {
+        error = "corrupt trace";
+        return false;
+    }
+
+    vertices.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        const char* fields = data + sizeof(TraceHeader) + static_cast<std::size_t>(i) * 3 * sizeof(double);
+        vertices.emplace_back(i, Point(readValue<double>(fields), readValue<double>(fields + sizeof(double))),
+                              readValue<double>(fields + 2 * sizeof(double)));
+    }
+
+    // Индекс записей. Оборванная последняя запись (прерванный прогон) отбрасывается,
+    // а запись, данных которой не хватает для декодирования, означает повреждённый файл.
+    while (offset + sizeof(TraceRecordHeader) <= size) {
+        TraceRecordHeader record = readValue<TraceRecordHeader>(data + offset);
+        std::size_t begin = offset + sizeof(TraceRecordHeader);
+        if (record.size > size - begin) {
+            break;
+        }
+        if (!isRecordValid(header, record, data + begin)) {
+            error = "corrupt trace record at offset " + std::to_string(offset);
+            records.clear();
+            keyframes.clear();
+            return false;
+        }
+
+        if (record.type == TraceKeyframe) {
+            keyframes.push_back(records.size());
+        }
+        records.push_back({ readValue<std::int32_t>(data + begin), record.type, begin });
+        offset = begin + record.size;
+    }
+
+    if (records.empty() || keyframes.empty() || keyframes.front() != 0) {
+        error = "trace has no keyframes";
+        records.clear();
+        return false;
+    }
+    return true;
+}
+
+bool TraceReader::seek(int iteration, ColonySnapshot& snapshot, int fullMatrixLimit, int edgesPerVertex) {
+    if (records.empty()) {
+        return false;
+    }
+
+    // Последняя запись не позже iteration и ключевой кадр перед ней
+    auto later = std::upper_bound(records.begin(), records.end(), iteration,
+                                  [](int value, const RecordEntry& entry) { return value < entry.iteration; });
+    std::size_t target = later == records.begin() ? 0 : static_cast<std::size_t>(later - records.begin()) - 1;
+    std::size_t frame = *(std::upper_bound(keyframes.begin(), keyframes.end(), target) - 1);
+
+    // Вперёд от уже декодированной записи - без повторного декодирования кадра
+    bool sameView = viewLimit == fullMatrixLimit && viewEdges == edgesPerVertex;
+    if (!decoded || frame != keyframe || target < position || !sameView) {
+        decodeKeyframe(frame, fullMatrixLimit, edgesPerVertex);
+    }
+    while (position < target) {
+        ++position;
+        applyDelta(position);
+    }
+
+    snapshot.iteration = records[target].iteration;
+    snapshot.maxIterations = getLastIteration();
+    snapshot.bestCost = bestCost;
+    snapshot.bestRoute = route;
+    snapshot.routeVersion = target;
+    snapshot.running = false;
+    snapshot.finished = false;
+    snapshot.island = -1;
+    snapshot.pheromoneView = pheromoneView;
+    return true;
+}
+
+void TraceReader::decodeKeyframe(std::size_t record, int fullMatrixLimit, int edgesPerVertex) {
+    const int n = getNumVertices();
+    const char* data = file.data() + records[record].offset;
+    int length = readValue<std::int32_t>(data + sizeof(std::int32_t));
+    bestCost = readValue<double>(data + 2 * sizeof(std::int32_t));
+    data += 2 * sizeof(std::int32_t) + sizeof(double);
+
+    length = std::min(std::max(length, 0), n);
+    route.resize(length);
+    for (int i = 0; i < length; ++i) {
+        route[i] = readValue<std::int32_t>(data + i * sizeof(std::int32_t));
+    }
+    data += length * sizeof(std::int32_t);
+
+    keyframe = record;
+    position = record;
+    decoded = true;
+    viewLimit = fullMatrixLimit;
+    viewEdges = edgesPerVertex;
+
+    if (!header.pheromones) {
+        pheromoneView.reset();
+        return;
+    }
+
+    double logLow = readValue<double>(data);
+    double logHigh = readValue<double>(data + sizeof(double));
+    const std::uint8_t* levels = reinterpret_cast<const std::uint8_t*>(data + 2 * sizeof(double));
+
+    float table[PheromoneLevels + 1];
+    for (int level = 0; level <= PheromoneLevels; ++level) {
+        table[level] = static_cast<float>(std::exp(logLow + (logHigh - logLow) * level / PheromoneLevels));
+    }
+
+    // Полная матрица феромонов кадра (из треугольника - отражением)
+    std::vector<float> matrix(static_cast<std::size_t>(n) * n, 0.0f);
+    for (int i = 0; i < n; ++i) {
+        for (int j = header.triangle ? i + 1 : 0; j < n; ++j) {
+            if (i != j) {
+                float value = table[*levels++];
+                matrix[static_cast<std::size_t>(i) * n + j] = value;
+                if (header.triangle) {
+                    matrix[static_cast<std::size_t>(j) * n + i] = value;
+                }
+            }
+        }
+    }
+
+    auto view = std::make_shared<PheromoneView>();
+    view->version = record + 1;
+    view->maxPheromone = *std::max_element(matrix.begin(), matrix.end());
+
+    if (n <= fullMatrixLimit) {
+        view->vertices = n;
+        view->matrix.swap(matrix);
+    } else {
+        const int k = std::min(edgesPerVertex, n - 1);
+        std::vector<SnapshotEdge> row;
+        auto stronger = [](const SnapshotEdge& a, const SnapshotEdge& b) { return a.pheromone > b.pheromone; };
+
+        for (int i = 0; i < n && k > 0; ++i) {
+            row.clear();
+            for (int j = 0; j < n; ++j) {
+                if (j != i) {
+                    row.push_back({ i, j, matrix[static_cast<std::size_t>(i) * n + j] });
+                }
+            }
+            std::partial_sort(row.begin(), row.begin() + k, row.end(), stronger);
+            view->topEdges.insert(view->topEdges.end(), row.begin(), row.begin() + k);
+        }
+    }
+    pheromoneView = view;
+}
+
+void TraceReader::applyDelta(std::size_t record) {
+    if (records[record].type == TraceKeyframe) {
+        decodeKeyframe(record, viewLimit, viewEdges);
+        return;
+    }
+
+    const int n = getNumVertices();
+    const char* data = file.data() + records[record].offset;
+    int runs = readValue<std::int32_t>(data + sizeof(std::int32_t));
+    bestCost = readValue<double>(data + 2 * sizeof(std::int32_t));
+    data += 2 * sizeof(std::int32_t) + sizeof(double);
+
+    for (int r = 0; r < runs; ++r) {
+        int start = readValue<std::int32_t>(data);
+        int length = readValue<std::int32_t>(data + sizeof(std::int32_t));
+        data += 2 * sizeof(std::int32_t);
+
+        // Первый маршрут после кадра без маршрута приходит одним участком с позиции 0
+        if (start < 0 || length < 0 || start + length > n) {
+            return;
+        }
+        if (static_cast<int>(route.size()) < start + length) {
+            route.resize(start + length);
+        }
+        for (int k = 0; k < length; ++k) {
+            route[start + k] = readValue<std::int32_t>(data + k * sizeof(std::int32_t));
+        }
+        data += length * sizeof(std::int32_t);
+    }
+}
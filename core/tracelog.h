@@ -0,0 +1,124 @@
+#ifndef TRACELOG_H
+#define TRACELOG_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "instance.h"
+#include "mappedfile.h"
+#include "solverrunner.h"
+
+class AntColony;
+
+// Версия формата трассы
+const std::uint32_t TraceVersion = 1;
+
+// Заголовок трассы; за ним - вершины (x, y, visitCost в double) и поток записей
+struct TraceHeader {
+    char magic[8];                  // "ACOTRACE"
+    std::uint32_t version;          // TraceVersion
+    std::uint32_t headerSize;       // sizeof(TraceHeader)
+    std::int32_t numVertices;
+    std::int32_t keyframeInterval;  // Итераций между ключевыми кадрами
+    std::int32_t pheromones;        // Ключевые кадры содержат феромоны
+    std::int32_t triangle;          // Феромоны - верхний треугольник (симметричная матрица)
+};
+
+// Запись трассы: заголовок и size байт данных
+enum TraceRecordType : std::uint32_t {
+    TraceIteration = 1,             // Итерация, стоимость и изменения лучшего маршрута
+    TraceKeyframe = 2               // Итерация, стоимость, весь маршрут и феромоны
+};
+
+struct TraceRecordHeader {
+    std::uint32_t type;
+    std::uint32_t size;
+};
+
+// Запись трассы прогона. После каждой итерации пишется короткая запись:
+// номер, лучшая стоимость и изменившиеся участки лучшего маршрута (маршрут
+// приводится к началу в вершине 0, изменения - непрерывные участки позиций).
+// Каждые keyframeInterval итераций пишется ключевой кадр с полным маршрутом
+// и, по желанию, феромонами, квантованными в 8 бит по логарифмической шкале.
+// Записи дописываются в файл по мере работы, в памяти хранится только
+// предыдущий маршрут.
+class TraceRecorder {
+public:
+    TraceRecorder() = default;
+    ~TraceRecorder();
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    // Создание файла для графа колонии (существующий файл перезаписывается)
+    bool open(const std::string& path, const AntColony& colony, int keyframeInterval,
+              bool pheromones, std::string& error);
+    void close();
+    bool isOpen() const { return file != nullptr; }
+
+    // Запись состояния после итерации
+    void record(const AntColony& colony);
+
+private:
+    void writeRecord(std::uint32_t type);
+    void writeKeyframe(const AntColony& colony);
+    template <typename T> void append(const T& value);
+
+    std::FILE* file = nullptr;
+    int numVertices = 0;
+    int keyframeInterval = 0;
+    bool pheromones = false;
+    bool triangle = false;
+    bool hasRecords = false;
+    std::vector<int> previousRoute;   // Лучший маршрут прошлой записи (с вершины 0)
+    std::vector<int> currentRoute;
+    std::vector<char> payload;        // Данные текущей записи
+};
+
+// Чтение трассы для воспроизведения. Файл отображается в память, при открытии
+// строится только индекс записей; переход к итерации декодирует ближайший
+// предшествующий ключевой кадр и изменения маршрута после него.
+class TraceReader {
+public:
+    bool open(const std::string& path, std::string& error);
+
+    int getNumVertices() const { return static_cast<int>(vertices.size()); }
+    const std::vector<Vertex>& getVertices() const { return vertices; }
+    int getFirstIteration() const { return records.empty() ? 0 : records.front().iteration; }
+    int getLastIteration() const { return records.empty() ? 0 : records.back().iteration; }
+    bool isEmpty() const { return records.empty(); }
+
+    // Снимок на итерации iteration (или последней записанной до неё). Феромоны
+    // берутся из ключевого кадра: полная матрица при N <= fullMatrixLimit,
+    // иначе edgesPerVertex сильнейших рёбер каждой вершины.
+    bool seek(int iteration, ColonySnapshot& snapshot, int fullMatrixLimit = 1000, int edgesPerVertex = 4);
+
+private:
+    struct RecordEntry {
+        int iteration;
+        std::uint32_t type;
+        std::size_t offset;           // Начало данных записи
+    };
+
+    void decodeKeyframe(std::size_t record, int fullMatrixLimit, int edgesPerVertex);
+    void applyDelta(std::size_t record);
+
+    MappedFile file;
+    TraceHeader header;
+    std::vector<Vertex> vertices;
+    std::vector<RecordEntry> records;
+    std::vector<std::size_t> keyframes;   // Индексы ключевых кадров в records
+
+    // Декодированное состояние (для последовательных переходов вперёд)
+    std::size_t position = 0;             // Последняя применённая запись
+    std::size_t keyframe = 0;             // Ключевой кадр, от которого декодировано
+    bool decoded = false;
+    double bestCost = 0.0;
+    std::vector<int> route;
+    std::shared_ptr<const PheromoneView> pheromoneView;
+    int viewLimit = 0;
+    int viewEdges = 0;
+};
+
+#endif // TRACELOG_H
@@ -0,0 +1,47 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+
+// Тройной буфер для передачи данных от одного писателя одному читателю без блокировок.
+// Писатель заполняет свой буфер и атомарно меняет его местами с промежуточным,
+// читатель забирает промежуточный буфер, если в нём есть новые данные.
+// Буферы переиспользуются, поэтому после прогрева память не выделяется.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : middle(2), back(0), front(1) {}
+
+    // Буфер писателя
+    T& writeBuffer() { return buffers[back]; }
+
+    // Публикация буфера писателя
+    void publish() {
+        int previous = middle.exchange(back | Dirty, std::memory_order_acq_rel);
+        back = previous & IndexMask;
+    }
+
+    // Получение последних опубликованных данных; false, если новых нет
+    bool update() {
+        if (!(middle.load(std::memory_order_acquire) & Dirty)) {
+            return false;
+        }
+        int previous = middle.exchange(front, std::memory_order_acq_rel);
+        front = previous & IndexMask;
+        return true;
+    }
+
+    // Буфер читателя (действителен до следующего update())
+    const T& readBuffer() const { return buffers[front]; }
+
+private:
+    static constexpr int IndexMask = 3;
+    static constexpr int Dirty = 4;
+
+    T buffers[3];
+    std::atomic<int> middle;   // Индекс промежуточного буфера и флаг новых данных
+    int back;                  // Индекс буфера писателя
+    int front;                 // Индекс буфера читателя
+};
+
+#endif // TRIPLEBUFFER_H
@@ -0,0 +1,427 @@
+#include "tsplib.h"
+#include "mappedfile.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <string_view>
+
+namespace {
+
+// Формат записи матрицы в EDGE_WEIGHT_SECTION
+enum class WeightFormat {
+    Unknown,
+    FullMatrix,
+    UpperRow,
+    LowerRow,
+    UpperDiagRow,
+    LowerDiagRow
+};
+
+// Последовательное чтение лексем из буфера без копирования
+class Cursor {
+public:
+    Cursor(const char* begin, const char* end) : p(begin), end(end) {}
+
+    bool atEnd() const { return p >= end; }
+
+    // Непрочитанных байт до конца буфера
+    std::size_t remaining() const { return p < end ? static_cast<std::size_t>(end - p) : 0; }
+
+    // Пропуск пробелов и переводов строк
+    void skipWhitespace() {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) {
+            ++p;
+        }
+    }
+
+    // Пропуск пробелов внутри строки
+    void skipSpaces() {
+        while (p < end && (*p == ' ' || *p == '\t')) {
+            ++p;
+        }
+    }
+
+    // Ключевое слово: буквы, цифры и '_'
+    std::string_view keyword() {
+        skipWhitespace();
+        const char* start = p;
+        while (p < end && (std::isalnum(static_cast<unsigned char>(*p)) || *p == '_')) {
+            ++p;
+        }
+        return std::string_view(start, static_cast<std::size_t>(p - start));
+    }
+
+    // Значение после необязательного ':' до конца строки (без крайних пробелов)
+    std::string_view value() {
+        skipSpaces();
+        if (p < end && *p == ':') {
+            ++p;
+        }
+        skipSpaces();
+
+        const char* start = p;
+        while (p < end && *p != '\n') {
+            ++p;
+        }
+
+        const char* stop = p;
+        while (stop > start && (stop[-1] == ' ' || stop[-1] == '\t' || stop[-1] == '\r')) {
+            --stop;
+        }
+        return std::string_view(start, static_cast<std::size_t>(stop - start));
+    }
+
+    bool number(double& result) {
+        skipWhitespace();
+        const char* start = p;
+
+        bool negative = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negative = (*p == '-');
+            ++p;
+        }
+
+        // Мантисса накапливается в целом числе (до 19 значащих цифр)
+        std::uint64_t mantissa = 0;
+        int significant = 0;
+        int exponent = 0;
+        bool anyDigits = false;
+
+        while (p < end && isDigit(*p)) {
+            appendDigit(*p - '0', mantissa, significant, exponent, false);
+            anyDigits = true;
+            ++p;
+        }
+
+        if (p < end && *p == '.') {
+            ++p;
+            while (p < end && isDigit(*p)) {
+                appendDigit(*p - '0', mantissa, significant, exponent, true);
+                anyDigits = true;
+                ++p;
+            }
+        }
+
+        if (!anyDigits) {
+            p = start;
+            return false;
+        }
+
+        if (p < end && (*p == 'e' || *p == 'E')) {
+            const char* exponentStart = p++;
+            bool negativeExponent = false;
+            if (p < end && (*p == '-' || *p == '+')) {
+                negativeExponent = (*p == '-');
+                ++p;
+            }
+
+            int value = 0;
+            bool exponentDigits = false;
+            while (p < end && isDigit(*p)) {
+                value = std::min(value * 10 + (*p - '0'), 100000);
+                exponentDigits = true;
+                ++p;
+            }
+
+            if (exponentDigits) {
+                exponent += negativeExponent ? -value : value;
+            } else {
+                p = exponentStart;
+            }
+        }
+
+        result = scale(static_cast<double>(mantissa), exponent);
+        if (negative) {
+            result = -result;
+        }
+        return true;
+    }
+
+private:
+    static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+    static void appendDigit(int digit, std::uint64_t& mantissa, int& significant, int& exponent, bool fraction) {
+        if (significant < 19) {
+            mantissa = mantissa * 10 + static_cast<std::uint64_t>(digit);
+            if (mantissa != 0) {
+                ++significant;
+            }
+            if (fraction) {
+                --exponent;
+            }
+        } else if (!fraction) {
+            ++exponent;
+        }
+    }
+
+    static double scale(double value, int exponent) {
+        // Степени 10 до 10^22 представимы в double точно
+        static const double powers[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        if (exponent == 0 || value == 0.0) {
+            return value;
+        }
+        if (exponent > 0) {
+            return exponent <= 22 ? value * powers[exponent] : value * std::pow(10.0, exponent);
+        }
+        return -exponent <= 22 ? value / powers[-exponent] : value / std::pow(10.0, -exponent);
+    }
+
+    const char* p;
+    const char* end;
+};
+
+bool parseMetric(std::string_view value, DistanceMetric& metric) {
+    if (value == "EUC_2D") metric = DistanceMetric::Euc2D;
+    else if (value == "CEIL_2D") metric = DistanceMetric::Ceil2D;
+    else if (value == "ATT") metric = DistanceMetric::Att;
+    else if (value == "GEO") metric = DistanceMetric::Geo;
+    else if (value == "EXPLICIT") metric = DistanceMetric::Explicit;
+    else return false;
+    return true;
+}
+
+WeightFormat parseWeightFormat(std::string_view value) {
+    if (value == "FULL_MATRIX") return WeightFormat::FullMatrix;
+    if (value == "UPPER_ROW") return WeightFormat::UpperRow;
+    if (value == "LOWER_ROW") return WeightFormat::LowerRow;
+    if (value == "UPPER_DIAG_ROW") return WeightFormat::UpperDiagRow;
+    if (value == "LOWER_DIAG_ROW") return WeightFormat::LowerDiagRow;
+    return WeightFormat::Unknown;
+}
+
+// Целое число из [low, high]: проверяется до приведения к int, так как
+// приведение NaN или значения вне диапазона int не определено
+bool isIntegerInRange(double value, double low, double high) {
+    return value >= low && value <= high && value == std::floor(value);
+}
+
+// Чтение координат "номер x y" для dimension вершин
+bool readCoordinates(Cursor& cursor, int dimension, std::vector<Vertex>& vertices, std::string& error) {
+    // Вершина занимает не меньше 6 байт ("1 0 0" и разделитель), поэтому
+    // DIMENSION больше, чем помещается в остатке файла, отвергается до выделения памяти
+    if ((cursor.remaining() + 1) / 6 < static_cast<std::size_t>(dimension)) {
+        error = "truncated coordinate section";
+        return false;
+    }
+
+    vertices.clear();
+    vertices.reserve(dimension);
+    for (int i = 0; i < dimension; ++i) {
+        vertices.emplace_back(i, Point(), 0.0);
+    }
+
+    std::vector<bool> seen(dimension, false);
+
+    for (int i = 0; i < dimension; ++i) {
+        double id, x, y;
+        if (!cursor.number(id) || !cursor.number(x) || !cursor.number(y)) {
+            error = "truncated coordinate section";
+            return false;
+        }
+
+        if (!isIntegerInRange(id, 1, dimension) || seen[static_cast<int>(id) - 1]) {
+            char text[32];
+            std::snprintf(text, sizeof(text), "%.15g", id);
+            error = "invalid or duplicate node number " + std::string(text);
+            return false;
+        }
+
+        int index = static_cast<int>(id) - 1;
+        seen[index] = true;
+        vertices[index].position = Point(x, y);
+    }
+    return true;
+}
+
+// Чтение матрицы расстояний в заданном формате
+bool readWeights(Cursor& cursor, int dimension, WeightFormat format, Matrix<double>& weights, std::string& error) {
+    // Число значений формата; каждое занимает не меньше 2 байт с разделителем
+    const std::size_t n = static_cast<std::size_t>(dimension);
+    std::size_t entries = 0;
+    switch (format) {
+    case WeightFormat::FullMatrix:   entries = n * n;           break;
+    case WeightFormat::UpperRow:
+    case WeightFormat::LowerRow:     entries = n * (n - 1) / 2; break;
+    case WeightFormat::UpperDiagRow:
+    case WeightFormat::LowerDiagRow: entries = n * (n + 1) / 2; break;
+    case WeightFormat::Unknown:
+        error = "unsupported EDGE_WEIGHT_FORMAT";
+        return false;
+    }
+    if ((cursor.remaining() + 1) / 2 < entries) {
+        error = "truncated EDGE_WEIGHT_SECTION";
+        return false;
+    }
+
+    weights.resize(dimension, dimension, 0.0);
+
+    for (int i = 0; i < dimension; ++i) {
+        int from = 0;
+        int to = dimension;
+
+        switch (format) {
+        case WeightFormat::FullMatrix:   from = 0;     to = dimension; break;
+        case WeightFormat::UpperRow:     from = i + 1; to = dimension; break;
+        case WeightFormat::UpperDiagRow: from = i;     to = dimension; break;
+        case WeightFormat::LowerRow:     from = 0;     to = i;         break;
+        case WeightFormat::LowerDiagRow: from = 0;     to = i + 1;     break;
+        case WeightFormat::Unknown:
+            error = "unsupported EDGE_WEIGHT_FORMAT";
+            return false;
+        }
+
+        double* row = weights.row(i);
+        for (int j = from; j < to; ++j) {
+            if (!cursor.number(row[j])) {
+                error = "truncated EDGE_WEIGHT_SECTION";
+                return false;
+            }
+        }
+    }
+
+    // Треугольные форматы задают симметричную матрицу
+    if (format != WeightFormat::FullMatrix) {
+        bool upper = (format == WeightFormat::UpperRow || format == WeightFormat::UpperDiagRow);
+        for (int i = 0; i < dimension; ++i) {
+            for (int j = i + 1; j < dimension; ++j) {
+                if (upper) {
+                    weights(j, i) = weights(i, j);
+                } else {
+                    weights(i, j) = weights(j, i);
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < dimension; ++i) {
+        weights(i, i) = 0.0;
+    }
+    return true;
+}
+
+// Расположение вершин по окружности (если у задачи нет координат отображения)
+void layoutOnCircle(std::vector<Vertex>& vertices) {
+    const double pi = 3.14159265358979323846;
+    const double radius = 500.0;
+    const int n = static_cast<int>(vertices.size());
+    for (int i = 0; i < n; ++i) {
+        double angle = 2.0 * pi * i / n;
+        vertices[i].position = Point(radius + radius * std::cos(angle), radius + radius * std::sin(angle));
+    }
+}
+
+} // namespace
+
+bool loadTsplib(const std::string& path, Instance& instance, std::string& error) {
+    MappedFile file;
+    if (!file.open(path)) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    Cursor cursor(file.data(), file.data() + file.size());
+
+    instance = Instance();
+    int dimension = 0;
+    bool hasMetric = false;
+    bool hasCoordinates = false;
+    bool hasWeights = false;
+    WeightFormat format = WeightFormat::Unknown;
+
+    while (true) {
+        cursor.skipWhitespace();
+        if (cursor.atEnd()) {
+            break;
+        }
+
+        std::string_view key = cursor.keyword();
+        if (key.empty()) {
+            error = "unexpected character in header";
+            return false;
+        }
+
+        if (key == "EOF") {
+            break;
+        } else if (key == "NODE_COORD_SECTION" || key == "DISPLAY_DATA_SECTION") {
+            if (dimension <= 0) {
+                error = std::string(key) + " before DIMENSION";
+                return false;
+            }
+            if (!readCoordinates(cursor, dimension, instance.vertices, error)) {
+                return false;
+            }
+            hasCoordinates = true;
+        } else if (key == "EDGE_WEIGHT_SECTION") {
+            if (dimension <= 0) {
+                error = "EDGE_WEIGHT_SECTION before DIMENSION";
+                return false;
+            }
+            if (!readWeights(cursor, dimension, format, instance.explicitDistances, error)) {
+                return false;
+            }
+            hasWeights = true;
+        } else if (key.size() > 8 && key.substr(key.size() - 8) == "_SECTION") {
+            error = "unsupported section " + std::string(key);
+            return false;
+        } else {
+            std::string_view value = cursor.value();
+
+            if (key == "NAME") {
+                instance.name = std::string(value);
+            } else if (key == "TYPE") {
+                if (value != "TSP" && value != "ATSP") {
+                    error = "unsupported problem type " + std::string(value);
+                    return false;
+                }
+            } else if (key == "DIMENSION") {
+                double parsed = 0.0;
+                Cursor number(value.data(), value.data() + value.size());
+                if (!number.number(parsed) || !isIntegerInRange(parsed, 2, std::numeric_limits<int>::max())) {
+                    error = "invalid DIMENSION";
+                    return false;
+                }
+                dimension = static_cast<int>(parsed);
+            } else if (key == "EDGE_WEIGHT_TYPE") {
+                if (!parseMetric(value, instance.metric)) {
+                    error = "unsupported EDGE_WEIGHT_TYPE " + std::string(value);
+                    return false;
+                }
+                hasMetric = true;
+            } else if (key == "EDGE_WEIGHT_FORMAT") {
+                format = parseWeightFormat(value);
+            }
+            // Остальные ключи (COMMENT, DISPLAY_DATA_TYPE, ...) не влияют на задачу
+        }
+    }
+
+    if (!hasMetric) {
+        error = "missing EDGE_WEIGHT_TYPE";
+        return false;
+    }
+
+    if (instance.metric == DistanceMetric::Explicit) {
+        if (!hasWeights) {
+            error = "missing EDGE_WEIGHT_SECTION";
+            return false;
+        }
+        if (!hasCoordinates) {
+            instance.vertices.clear();
+            for (int i = 0; i < dimension; ++i) {
+                instance.vertices.emplace_back(i, Point(), 0.0);
+            }
+            layoutOnCircle(instance.vertices);
+        }
+    } else if (!hasCoordinates) {
+        error = "missing NODE_COORD_SECTION";
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,15 @@
+#ifndef TSPLIB_H
+#define TSPLIB_H
+
+#include <string>
+#include "instance.h"
+
+// Загрузка задачи в формате TSPLIB (TSP/ATSP).
+// Поддерживаются NODE_COORD_SECTION с метриками EUC_2D, CEIL_2D, ATT, GEO
+// и EDGE_WEIGHT_SECTION (EXPLICIT) в форматах FULL_MATRIX, UPPER_ROW,
+// LOWER_ROW, UPPER_DIAG_ROW, LOWER_DIAG_ROW. Файл читается напрямую из
+// отображения в память, без выделения строк на каждую запись.
+// При ошибке возвращает false и описание ошибки в error.
+bool loadTsplib(const std::string& path, Instance& instance, std::string& error);
+
+#endif // TSPLIB_H
@@ -0,0 +1,141 @@
+#include "tuner.h"
+#include "threadpool.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+
+std::vector<TuningCandidate> ParameterTuner::buildCandidates() const {
+    // Полная сетка; при превышении maxCandidates - случайная выборка без повторов
+    std::vector<TuningCandidate> grid;
+    for (int a = 0; a < std::max(1, space.ants.levels); ++a) {
+        for (int al = 0; al < std::max(1, space.alpha.levels); ++al) {
+            for (int b = 0; b < std::max(1, space.beta.levels); ++b) {
+                for (int r = 0; r < std::max(1, space.rho.levels); ++r) {
+                    for (int q = 0; q < std::max(1, space.Q.levels); ++q) {
+                        TuningCandidate candidate;
+                        candidate.ants = std::max(1, static_cast<int>(std::lround(space.ants.value(a))));
+                        candidate.alpha = space.alpha.value(al);
+                        candidate.beta = space.beta.value(b);
+                        candidate.rho = space.rho.value(r);
+                        candidate.Q = space.Q.value(q);
+                        grid.push_back(candidate);
+                    }
+                }
+            }
+        }
+    }
+
+    if (settings.maxCandidates > 0 && static_cast<int>(grid.size()) > settings.maxCandidates) {
+        std::mt19937 rng(settings.seed);
+        std::shuffle(grid.begin(), grid.end(), rng);
+        grid.resize(settings.maxCandidates);
+    }
+    return grid;
+}
+
+std::vector<TuningResult> ParameterTuner::run() {
+    candidates = buildCandidates();
+
+    std::vector<TuningResult> results(candidates.size());
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        results[i].candidate = candidates[i];
+    }
+    if (instances.empty() || candidates.empty()) {
+        return results;
+    }
+
+    std::vector<int> survivors(candidates.size());
+    std::iota(survivors.begin(), survivors.end(), 0);
+
+    int eta = std::max(2, settings.eta);
+    int iterations = std::max(1, settings.iterations);
+    for (int round = 0; ; ++round) {
+        if (progress) {
+            progress(round, static_cast<int>(survivors.size()), iterations);
+        }
+        evaluateRound(survivors, iterations, results);
+
+        // В следующий раунд проходят лучшие по среднему разрыву; когда остаётся
+        // один набор, он уже лучший среди участников последнего раунда
+        std::size_t keep = (survivors.size() + eta - 1) / eta;
+        if (keep <= 1) {
+            break;
+        }
+        std::stable_sort(survivors.begin(), survivors.end(), [&results](int a, int b) {
+            return results[a].meanGap < results[b].meanGap;
+        });
+        survivors.resize(keep);
+        iterations *= eta;
+    }
+
+    // Сначала наборы, дошедшие до более поздних раундов, внутри раунда - по разрыву
+    std::stable_sort(results.begin(), results.end(), [](const TuningResult& a, const TuningResult& b) {
+        if (a.rounds != b.rounds) {
+            return a.rounds > b.rounds;
+        }
+        return a.meanGap < b.meanGap;
+    });
+    return results;
+}
+
+void ParameterTuner::evaluateRound(const std::vector<int>& survivors, int iterations,
+                                   std::vector<TuningResult>& results) {
+    // Прогон - набор x задача x зерно; зёрна общие для всех наборов, поэтому
+    // наборы сравниваются на одинаковых случайных последовательностях
+    const int seeds = std::max(1, settings.seeds);
+    const int runsPerCandidate = static_cast<int>(instances.size()) * seeds;
+    const int runs = static_cast<int>(survivors.size()) * runsPerCandidate;
+    std::vector<double> costs(runs);
+
+    std::atomic<int> next(0);
+    auto worker = [&](int) {
+        for (int run = next.fetch_add(1); run < runs; run = next.fetch_add(1)) {
+            const TuningCandidate& candidate = candidates[survivors[run / runsPerCandidate]];
+            int instance = run % runsPerCandidate / seeds;
+            int seed = run % seeds;
+
+            AntColony colony(static_cast<int>(instances[instance].vertices.size()), candidate.ants,
+                             candidate.alpha, candidate.beta, candidate.rho, candidate.Q, iterations);
+            colony.setSeed(settings.seed + 7919u * instance + seed);
+            if (settings.configure) {
+                settings.configure(colony);
+            }
+            colony.setThreadCount(1);
+            colony.setInstance(instances[instance]);
+            colony.run();
+            costs[run] = colony.getBestCost();
+        }
+    };
+
+    int threads = std::max(1, std::min(settings.threads, runs));
+    if (threads > 1) {
+        ThreadPool pool(threads);
+        pool.run(worker);
+    } else {
+        worker(0);
+    }
+
+    // Лучший прогон раунда на каждой задаче (по всем наборам и зёрнам)
+    std::vector<double> best(instances.size(), std::numeric_limits<double>::max());
+    for (int run = 0; run < runs; ++run) {
+        int instance = run % runsPerCandidate / seeds;
+        best[instance] = std::min(best[instance], costs[run]);
+    }
+
+    for (size_t s = 0; s < survivors.size(); ++s) {
+        TuningResult& result = results[survivors[s]];
+        double gap = 0.0;
+        for (int r = 0; r < runsPerCandidate; ++r) {
+            int run = static_cast<int>(s) * runsPerCandidate + r;
+            int instance = r / seeds;
+            gap += costs[run] / best[instance] - 1.0;
+        }
+        result.meanGap = gap / runsPerCandidate;
+        result.rounds += 1;
+        result.evaluations += runsPerCandidate;
+        result.iterations = iterations;
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef TUNER_H
+#define TUNER_H
+
+#include <functional>
+#include <vector>
+#include "antcolony.h"
+#include "instance.h"
+
+// Диапазон параметра: levels значений равномерно от low до high (1 - только low)
+struct TuningRange {
+    double low;
+    double high;
+    int levels;
+
+    TuningRange(double value = 0.0) : low(value), high(value), levels(1) {}
+    TuningRange(double low, double high, int levels) : low(low), high(high), levels(levels) {}
+
+    double value(int level) const {
+        return levels > 1 ? low + (high - low) * level / (levels - 1) : low;
+    }
+};
+
+// Пространство поиска: сетка по всем параметрам
+struct TuningSpace {
+    TuningRange ants = 20.0;
+    TuningRange alpha = 1.0;
+    TuningRange beta = 2.0;
+    TuningRange rho = 0.5;
+    TuningRange Q = 100.0;
+};
+
+// Набор параметров колонии
+struct TuningCandidate {
+    int ants;
+    double alpha;
+    double beta;
+    double rho;
+    double Q;
+};
+
+// Настройки отбора
+struct TuningSettings {
+    int iterations = 25;        // Итераций на прогон в первом раунде; в каждом следующем - в eta раз больше
+    int seeds = 3;              // Прогонов с разными зёрнами на каждую задачу
+    int eta = 2;                // В следующий раунд проходит 1 / eta лучших наборов
+    int maxCandidates = 64;     // Если сетка больше, берётся случайная выборка наборов
+    int threads = 1;            // Прогоны выполняются параллельно, у каждой колонии один поток
+    unsigned int seed = 1;
+    std::function<void(AntColony&)> configure;  // Остальные настройки колонии (вариант, кандидаты...)
+};
+
+// Итог для набора: результат последнего раунда, в котором он участвовал
+struct TuningResult {
+    TuningCandidate candidate;
+    double meanGap = 0.0;       // Средний разрыв до лучшего прогона раунда на той же задаче (доля)
+    int rounds = 0;             // Раундов, в которых участвовал набор
+    int evaluations = 0;        // Прогонов всего
+    int iterations = 0;         // Итераций на прогон в последнем раунде
+};
+
+// Подбор параметров последовательным отсевом (successive halving). В каждом
+// раунде все оставшиеся наборы запускаются на всех задачах с одними и теми же
+// зёрнами; наборы ранжируются по среднему разрыву до лучшего прогона раунда
+// на каждой задаче, и в следующий раунд с бюджетом в eta раз больше проходит
+// 1 / eta лучших. Плохие наборы отсеиваются на коротких прогонах, а длинные
+// прогоны достаются немногим лучшим.
+class ParameterTuner {
+public:
+    void setSpace(const TuningSpace& value) { space = value; }
+    void setSettings(const TuningSettings& value) { settings = value; }
+    void addInstance(const Instance& instance) { instances.push_back(instance); }
+    int getInstanceCount() const { return static_cast<int>(instances.size()); }
+
+    // Вызывается перед каждым раундом: номер раунда (с 0), наборов и итераций на прогон
+    void setProgressCallback(std::function<void(int round, int candidates, int iterations)> callback) {
+        progress = std::move(callback);
+    }
+
+    // Отбор; результаты упорядочены от лучшего (дольше всех участвовавшего) набора
+    std::vector<TuningResult> run();
+
+private:
+    std::vector<TuningCandidate> buildCandidates() const;
+    void evaluateRound(const std::vector<int>& survivors, int iterations, std::vector<TuningResult>& results);
+
+    TuningSpace space;
+    TuningSettings settings;
+    std::vector<Instance> instances;
+    std::vector<TuningCandidate> candidates;
+    std::function<void(int, int, int)> progress;
+};
+
+#endif // TUNER_H
@@ -0,0 +1,475 @@
+#include "graphscene.h"
+#include <QDebug>
+#include <QImage>
+#include <QPainter>
+#include <QPixmap>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Количество уровней феромона: перо ребра меняется, только если меняется уровень
+const int PheromoneLevels = 256;
+
+// Радиус вершины для небольших графов
+const double MaxVertexRadius = 25.0;
+
+// Минимальный экранный радиус вершины (в пикселях), при котором видны подписи
+const double LabelMinRadius = 10.0;
+
+// Стрелки направления рисуются только на небольших графах
+const size_t MaxArrowVertices = 500;
+
+// Длинная сторона растра тепловой карты и минимальный интервал его перестроения
+const int HeatMapResolution = 2048;
+const int HeatMapInterval = 250;
+
+} // namespace
+
+GraphScene::GraphScene(QObject* parent)
+    : QGraphicsScene(parent), vertexRadius(MaxVertexRadius), labelsShown(false), topEdgeCount(0),
+      heatMapItem(nullptr), heatMapVersion(0), edgeMode(EdgeLines), edgesVersion(0),
+      routeVersion(0), routeShown(false), edgesShown(false)
+{
+    setBackgroundBrush(QBrush(QColor(250, 250, 250)));
+
+    // Пространственный индекс: при масштабировании и перетаскивании
+    // отрисовываются только элементы в видимой области
+    setItemIndexMethod(QGraphicsScene::BspTreeIndex);
+}
+
+void GraphScene::clearGraph() {
+    clear();
+    vertexItems.clear();
+    textItems.clear();
+    labelsShown = false;
+    edgeItems.clear();
+    edgeLevels.clear();
+    topEdgeItems.clear();
+    topEdgeLevels.clear();
+    topEdgeCount = 0;
+    heatMapItem = nullptr;
+    heatMapVersion = 0;
+    heatMapTimer.invalidate();
+    edgesVersion = 0;
+    routeItems.clear();
+    routeShown = false;
+    edgesShown = false;
+}
+
+void GraphScene::setGraph(const std::vector<Vertex>& graphVertices) {
+    clearGraph();
+    vertices = graphVertices;
+    if (vertices.empty()) return;
+
+    double minX = vertices[0].position.x, maxX = minX;
+    double minY = vertices[0].position.y, maxY = minY;
+    for (const auto& vertex : vertices) {
+        minX = std::min(minX, vertex.position.x);
+        maxX = std::max(maxX, vertex.position.x);
+        minY = std::min(minY, vertex.position.y);
+        maxY = std::max(maxY, vertex.position.y);
+    }
+    graphBounds = QRectF(minX, minY, std::max(maxX - minX, 1.0), std::max(maxY - minY, 1.0));
+
+    // Радиус уменьшается с ростом плотности вершин, чтобы круги не сливались
+    double extent = std::max(graphBounds.width(), graphBounds.height());
+    vertexRadius = std::min(MaxVertexRadius, 0.3 * extent / std::sqrt(static_cast<double>(vertices.size())));
+
+    // Фиксированный прямоугольник сцены: индекс не пересчитывает границы при изменении рёбер
+    double margin = 2 * vertexRadius;
+    setSceneRect(graphBounds.adjusted(-margin, -margin, margin, margin));
+
+    vertexItems.reserve(vertices.size());
+    for (const auto& vertex : vertices) {
+        drawVertex(vertex);
+    }
+}
+
+void GraphScene::updateFrame(const ColonySnapshot& snapshot, bool showAllEdges, bool showBestRoute) {
+    if (vertices.empty()) return;
+
+    if (showAllEdges != edgesShown) {
+        edgesShown = showAllEdges;
+        applyEdgeVisibility();
+    }
+
+    // Рёбра с феромонами перерисовываются, только если представление обновилось
+    const PheromoneView* view = snapshot.pheromoneView.get();
+    if (showAllEdges && view) {
+        if (edgeMode == EdgeHeatMap) {
+            updateHeatMap(*view, !snapshot.running);
+        } else if (view->version != edgesVersion) {
+            updatePheromoneEdges(*view);
+            updateTopEdges(*view);
+            edgesVersion = view->version;
+        }
+    }
+
+    // Лучший маршрут перестраивается только при изменении
+    bool needRoute = showBestRoute && snapshot.bestRoute.size() >= 2;
+    if (!needRoute) {
+        clearBestRoute();
+    } else if (!routeShown || snapshot.routeVersion != routeVersion) {
+        rebuildBestRoute(snapshot.bestRoute);
+        routeVersion = snapshot.routeVersion;
+    }
+}
+
+void GraphScene::setEdgeMode(EdgeMode mode) {
+    if (mode == edgeMode) return;
+    edgeMode = mode;
+
+    // Элементы другого способа отображения освобождаются
+    if (edgeMode == EdgeHeatMap) {
+        clearPheromoneEdges();
+        for (QGraphicsLineItem* line : topEdgeItems) {
+            removeItem(line);
+            delete line;
+        }
+        topEdgeItems.clear();
+        topEdgeLevels.clear();
+        topEdgeCount = 0;
+    } else if (heatMapItem) {
+        removeItem(heatMapItem);
+        delete heatMapItem;
+        heatMapItem = nullptr;
+    }
+
+    edgesVersion = 0;
+    heatMapVersion = 0;
+    heatMapTimer.invalidate();
+}
+
+void GraphScene::setViewScale(double scale) {
+    bool visible = vertexRadius * scale >= LabelMinRadius;
+    if (visible != labelsShown) {
+        setLabelsVisible(visible);
+    }
+}
+
+double GraphScene::pheromoneScale(const PheromoneView& view) {
+    return view.maxPheromone > 0.0f ? static_cast<double>(view.maxPheromone) : 1.0;
+}
+
+QPointF GraphScene::vertexPoint(int index) const {
+    return QPointF(vertices[index].position.x, vertices[index].position.y);
+}
+
+void GraphScene::drawVertex(const Vertex& vertex) {
+    double radius = vertexRadius;
+
+    // Круг вершины (толщина контура не зависит от масштаба)
+    QPen outline(QColor(50, 50, 150), 2);
+    outline.setCosmetic(true);
+
+    QGraphicsEllipseItem* circle = addEllipse(
+        vertex.position.x - radius,
+        vertex.position.y - radius,
+        2 * radius, 2 * radius,
+        outline,
+        QBrush(QColor(100, 150, 255))
+        );
+    vertexItems.push_back(circle);
+}
+
+void GraphScene::createLabels() {
+    // Подписи масштабируются вместе с кругом вершины
+    double labelScale = vertexRadius / MaxVertexRadius;
+    textItems.reserve(2 * vertices.size());
+
+    for (const auto& vertex : vertices) {
+        // Номер вершины
+        QGraphicsTextItem* idText = addText(QString::number(vertex.id));
+        idText->setDefaultTextColor(Qt::white);
+        idText->setFont(QFont("Arial", 10, QFont::Bold));
+        idText->setScale(labelScale);
+        QRectF textRect = idText->boundingRect();
+        idText->setPos(
+            vertex.position.x - labelScale * textRect.width() / 2,
+            vertex.position.y - labelScale * (textRect.height() / 2 + 5)
+            );
+        textItems.push_back(idText);
+
+        // Стоимость посещения
+        QGraphicsTextItem* costText = addText(QString("$%1").arg(vertex.visitCost, 0, 'f', 1));
+        costText->setDefaultTextColor(Qt::white);
+        costText->setFont(QFont("Arial", 8));
+        costText->setScale(labelScale);
+        QRectF costRect = costText->boundingRect();
+        costText->setPos(
+            vertex.position.x - labelScale * costRect.width() / 2,
+            vertex.position.y - labelScale * (costRect.height() / 2 - 5)
+            );
+        textItems.push_back(costText);
+    }
+}
+
+void GraphScene::setLabelsVisible(bool visible) {
+    if (visible && textItems.empty()) {
+        createLabels();
+    }
+    for (QGraphicsTextItem* text : textItems) {
+        text->setVisible(visible);
+    }
+    labelsShown = visible;
+}
+
+void GraphScene::updatePheromoneEdges(const PheromoneView& view) {
+    const int n = view.vertices;
+    if (n != static_cast<int>(vertices.size())) {
+        // Представление без полной матрицы: рёбра прошлых кадров не нужны
+        clearPheromoneEdges();
+        return;
+    }
+
+    // Элементы создаются при первом кадре с полной матрицей
+    if (edgeItems.empty()) {
+        edgeItems.assign(static_cast<size_t>(n) * n, nullptr);
+        edgeLevels.assign(static_cast<size_t>(n) * n, -1);
+    }
+
+    // Нормализация по максимальному уровню феромона (масштаб зависит от варианта алгоритма)
+    double maxPheromone = pheromoneScale(view);
+
+    // Симметричная пара рисуется одним ребром по большему из двух направлений
+    for (int i = 0; i < n; ++i) {
+        const float* row = view.matrix.data() + static_cast<size_t>(i) * n;
+
+        for (int j = i + 1; j < n; ++j) {
+            double pheromone = std::max(row[j], view.matrix[static_cast<size_t>(j) * n + i]);
+            int level = std::min(PheromoneLevels - 1, static_cast<int>(pheromone / maxPheromone * (PheromoneLevels - 1)));
+
+            size_t index = static_cast<size_t>(i) * n + j;
+            if (edgeLevels[index] == level) {
+                continue;
+            }
+
+            QGraphicsLineItem*& line = edgeItems[index];
+            if (!line) {
+                line = addLine(QLineF(vertexPoint(i), vertexPoint(j)));
+                line->setZValue(-1);
+                line->setVisible(edgesShown);
+            }
+
+            applyEdgeStyle(line, level);
+            edgeLevels[index] = level;
+        }
+    }
+}
+
+void GraphScene::updateTopEdges(const PheromoneView& view) {
+    double maxPheromone = pheromoneScale(view);
+
+    // Пул элементов растёт до максимального числа рёбер, лишние скрываются
+    while (topEdgeItems.size() < view.topEdges.size()) {
+        QGraphicsLineItem* line = addLine(QLineF());
+        line->setZValue(-1);
+        topEdgeItems.push_back(line);
+        topEdgeLevels.push_back(-1);
+    }
+
+    for (size_t k = 0; k < topEdgeItems.size(); ++k) {
+        QGraphicsLineItem* line = topEdgeItems[k];
+
+        if (k >= view.topEdges.size()) {
+            line->setVisible(false);
+            continue;
+        }
+
+        const SnapshotEdge& edge = view.topEdges[k];
+        QLineF segment(vertexPoint(edge.from), vertexPoint(edge.to));
+        if (line->line() != segment) {
+            line->setLine(segment);
+        }
+
+        int level = std::min(PheromoneLevels - 1, static_cast<int>(edge.pheromone / maxPheromone * (PheromoneLevels - 1)));
+        if (topEdgeLevels[k] != level) {
+            applyEdgeStyle(line, level);
+            topEdgeLevels[k] = level;
+        }
+        line->setVisible(edgesShown);
+    }
+    topEdgeCount = view.topEdges.size();
+}
+
+void GraphScene::updateHeatMap(const PheromoneView& view, bool force) {
+    // Растр перестраивается не чаще HeatMapInterval, кроме последнего кадра после остановки
+    if (view.version == heatMapVersion) return;
+    if (!force && heatMapTimer.isValid() && heatMapTimer.elapsed() < HeatMapInterval) return;
+
+    double pixelsPerUnit = HeatMapResolution / std::max(graphBounds.width(), graphBounds.height());
+    QSize size(std::max(1, static_cast<int>(std::ceil(graphBounds.width() * pixelsPerUnit))),
+               std::max(1, static_cast<int>(std::ceil(graphBounds.height() * pixelsPerUnit))));
+
+    // Рёбра представления: из полной матрицы (по большему направлению) или прореженные
+    std::vector<SnapshotEdge> edges;
+    const int n = view.vertices;
+    if (n == static_cast<int>(vertices.size())) {
+        edges.reserve(static_cast<size_t>(n) * (n - 1) / 2);
+        for (int i = 0; i < n; ++i) {
+            for (int j = i + 1; j < n; ++j) {
+                float pheromone = std::max(view.matrix[static_cast<size_t>(i) * n + j],
+                                           view.matrix[static_cast<size_t>(j) * n + i]);
+                edges.push_back({ i, j, pheromone });
+            }
+        }
+    } else {
+        edges = view.topEdges;
+    }
+
+    // Сильные рёбра рисуются поверх слабых
+    std::sort(edges.begin(), edges.end(),
+              [](const SnapshotEdge& a, const SnapshotEdge& b) { return a.pheromone < b.pheromone; });
+
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.scale(pixelsPerUnit, pixelsPerUnit);
+    painter.translate(-graphBounds.topLeft());
+
+    double maxPheromone = pheromoneScale(view);
+    for (const SnapshotEdge& edge : edges) {
+        double normalized = std::min(1.0, edge.pheromone / maxPheromone);
+
+        QColor color = getPheromoneColor(normalized, 1.0);
+        color.setAlphaF(0.15 + normalized * 0.75);
+        QPen pen(color, 1.0 + normalized * 1.5);
+        pen.setCosmetic(true);
+
+        painter.setPen(pen);
+        painter.drawLine(vertexPoint(edge.from), vertexPoint(edge.to));
+    }
+    painter.end();
+
+    if (!heatMapItem) {
+        heatMapItem = addPixmap(QPixmap());
+        heatMapItem->setZValue(-1);
+        heatMapItem->setTransformationMode(Qt::SmoothTransformation);
+        heatMapItem->setVisible(edgesShown);
+    }
+    heatMapItem->setPixmap(QPixmap::fromImage(image));
+    heatMapItem->setPos(graphBounds.topLeft());
+    heatMapItem->setScale(1.0 / pixelsPerUnit);
+
+    heatMapVersion = view.version;
+    heatMapTimer.restart();
+}
+
+void GraphScene::clearPheromoneEdges() {
+    for (QGraphicsLineItem* line : edgeItems) {
+        if (line) {
+            removeItem(line);
+            delete line;
+        }
+    }
+    edgeItems.clear();
+    edgeLevels.clear();
+}
+
+void GraphScene::applyEdgeVisibility() {
+    for (QGraphicsLineItem* line : edgeItems) {
+        if (line) {
+            line->setVisible(edgesShown);
+        }
+    }
+    for (size_t k = 0; k < topEdgeItems.size(); ++k) {
+        topEdgeItems[k]->setVisible(edgesShown && k < topEdgeCount);
+    }
+    if (heatMapItem) {
+        heatMapItem->setVisible(edgesShown);
+    }
+}
+
+void GraphScene::applyEdgeStyle(QGraphicsLineItem* line, int level) {
+    // Обычное ребро с цветом, зависящим от феромона
+    double normalizedPheromone = static_cast<double>(level) / (PheromoneLevels - 1);
+    QColor color = getPheromoneColor(normalizedPheromone, 1.0);
+    double width = 1.0 + normalizedPheromone * 2.0;
+
+    QPen pen(color, width, Qt::SolidLine);
+    pen.setCosmetic(true);
+    line->setPen(pen);
+    line->setOpacity(0.3 + normalizedPheromone * 0.4);
+}
+
+void GraphScene::clearBestRoute() {
+    for (QGraphicsLineItem* item : routeItems) {
+        removeItem(item);
+        delete item;
+    }
+    routeItems.clear();
+    routeShown = false;
+}
+
+void GraphScene::rebuildBestRoute(const std::vector<int>& bestRoute) {
+    // Маршрут той же длины без стрелок обновляется на месте
+    bool arrows = vertices.size() <= MaxArrowVertices;
+    if (arrows || routeItems.size() != bestRoute.size()) {
+        clearBestRoute();
+    }
+
+    // Отрисовка лучшего маршрута
+    for (size_t i = 0; i < bestRoute.size(); ++i) {
+        int from = bestRoute[i];
+        int to = bestRoute[(i + 1) % bestRoute.size()];
+
+        if (i < routeItems.size()) {
+            routeItems[i]->setLine(QLineF(vertexPoint(from), vertexPoint(to)));
+        } else {
+            drawRouteEdge(vertexPoint(from), vertexPoint(to));
+        }
+    }
+    routeShown = true;
+}
+
+void GraphScene::drawRouteEdge(const QPointF& p1, const QPointF& p2) {
+    // Лучший маршрут - толстая зелёная линия
+    QPen routePen(QColor(0, 200, 0), 4, Qt::SolidLine);
+    routePen.setCosmetic(true);
+
+    QGraphicsLineItem* line = addLine(p1.x(), p1.y(), p2.x(), p2.y(), routePen);
+    line->setZValue(10);
+    routeItems.push_back(line);
+
+    if (vertices.size() > MaxArrowVertices) {
+        return;
+    }
+
+    // Стрелка направления
+    double angle = std::atan2(p2.y() - p1.y(), p2.x() - p1.x());
+    double arrowSize = 0.6 * vertexRadius;
+    QPointF midPoint = (p1 + p2) / 2;
+
+    QPointF arrowP1 = midPoint - QPointF(
+                          arrowSize * std::cos(angle - M_PI / 6),
+                          arrowSize * std::sin(angle - M_PI / 6)
+                          );
+    QPointF arrowP2 = midPoint - QPointF(
+                          arrowSize * std::cos(angle + M_PI / 6),
+                          arrowSize * std::sin(angle + M_PI / 6)
+                          );
+
+    QPen arrowPen(QColor(0, 200, 0), 3);
+    arrowPen.setCosmetic(true);
+
+    QGraphicsLineItem* arrow1 = addLine(midPoint.x(), midPoint.y(), arrowP1.x(), arrowP1.y(), arrowPen);
+    QGraphicsLineItem* arrow2 = addLine(midPoint.x(), midPoint.y(), arrowP2.x(), arrowP2.y(), arrowPen);
+    arrow1->setZValue(10);
+    arrow2->setZValue(10);
+    routeItems.push_back(arrow1);
+    routeItems.push_back(arrow2);
+}
+
+QColor GraphScene::getPheromoneColor(double pheromone, double maxPheromone) {
+    // Градиент от синего (мало феромона) к красному (много феромона)
+    double normalized = pheromone / maxPheromone;
+
+    int r = static_cast<int>(normalized * 255);
+    int b = static_cast<int>((1.0 - normalized) * 255);
+    int g = 100;
+
+    return QColor(r, g, b);
+}
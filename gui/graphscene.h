@@ -0,0 +1,103 @@
+#ifndef GRAPHSCENE_H
+#define GRAPHSCENE_H
+
+#include <QGraphicsScene>
+#include <QGraphicsEllipseItem>
+#include <QGraphicsLineItem>
+#include <QGraphicsPixmapItem>
+#include <QGraphicsTextItem>
+#include <QElapsedTimer>
+#include <QPen>
+#include <QBrush>
+#include "antcolony.h"
+#include "solverrunner.h"
+
+// Сцена графа. Элементы вершин создаются один раз при задании графа,
+// элементы рёбер живут между кадрами и меняют только перо и прозрачность,
+// лучший маршрут перестраивается только при его изменении.
+// Для больших графов феромоны рисуются растровой тепловой картой,
+// а подписи вершин скрываются при мелком масштабе.
+class GraphScene : public QGraphicsScene {
+    Q_OBJECT
+
+public:
+    // Способ отображения феромонов
+    enum EdgeMode {
+        EdgeLines,      // Отдельный элемент на каждое ребро
+        EdgeHeatMap     // Растровая тепловая карта
+    };
+
+    explicit GraphScene(QObject* parent = nullptr);
+
+    // Задание нового графа (создание вершин)
+    void setGraph(const std::vector<Vertex>& vertices);
+
+    // Обновление рёбер и лучшего маршрута по снимку состояния решателя
+    void updateFrame(const ColonySnapshot& snapshot, bool showAllEdges = true, bool showBestRoute = false);
+
+    // Способ отображения феромонов
+    void setEdgeMode(EdgeMode mode);
+    EdgeMode getEdgeMode() const { return edgeMode; }
+
+    // Масштаб вида (пикселей на единицу сцены): подписи показываются,
+    // только если вершина на экране достаточно крупная
+    void setViewScale(double scale);
+
+    // Очистка сцены
+    void clearGraph();
+
+private:
+    // Вспомогательные методы отрисовки
+    void drawVertex(const Vertex& vertex);
+    void createLabels();
+    void setLabelsVisible(bool visible);
+    void updatePheromoneEdges(const PheromoneView& view);
+    void updateTopEdges(const PheromoneView& view);
+    void updateHeatMap(const PheromoneView& view, bool force);
+    void clearPheromoneEdges();
+    void applyEdgeVisibility();
+    void rebuildBestRoute(const std::vector<int>& bestRoute);
+    void clearBestRoute();
+    void drawRouteEdge(const QPointF& p1, const QPointF& p2);
+    void applyEdgeStyle(QGraphicsLineItem* line, int level);
+    QPointF vertexPoint(int index) const;
+    static double pheromoneScale(const PheromoneView& view);
+
+    // Получение цвета на основе уровня феромона
+    QColor getPheromoneColor(double pheromone, double maxPheromone);
+
+    // Вершины графа
+    std::vector<Vertex> vertices;
+    QRectF graphBounds;                // Охватывающий прямоугольник вершин
+    double vertexRadius;
+
+    // Списки графических элементов
+    std::vector<QGraphicsEllipseItem*> vertexItems;
+    std::vector<QGraphicsTextItem*> textItems;   // Создаются при первом показе
+    bool labelsShown;
+
+    // Рёбра полной матрицы: одно на пару (i < j), индекс пары i * N + j
+    std::vector<QGraphicsLineItem*> edgeItems;
+    std::vector<int> edgeLevels;       // Последний применённый уровень феромона (0..255)
+
+    // Рёбра прореженного вида (переиспользуемый пул)
+    std::vector<QGraphicsLineItem*> topEdgeItems;
+    std::vector<int> topEdgeLevels;
+    size_t topEdgeCount;               // Количество используемых элементов пула
+
+    // Тепловая карта
+    QGraphicsPixmapItem* heatMapItem;
+    QElapsedTimer heatMapTimer;        // Время с последней растеризации
+    unsigned long long heatMapVersion; // Версия растеризованного представления
+
+    EdgeMode edgeMode;
+    unsigned long long edgesVersion;   // Версия представления, отображённая линиями
+
+    // Лучший маршрут
+    std::vector<QGraphicsLineItem*> routeItems;
+    unsigned long long routeVersion;   // Версия отображённого маршрута
+    bool routeShown;
+    bool edgesShown;
+};
+
+#endif // GRAPHSCENE_H
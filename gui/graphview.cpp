@@ -0,0 +1,67 @@
+#include "graphview.h"
+#include <QWheelEvent>
+#include <QMouseEvent>
+#include <QResizeEvent>
+#include <cmath>
+
+namespace {
+
+// Шаг масштабирования на одно деление колеса мыши
+const double ZoomStep = 1.15;
+
+} // namespace
+
+GraphView::GraphView(QGraphicsScene* scene, QWidget* parent)
+    : QGraphicsView(scene, parent), autoFit(true)
+{
+    setDragMode(QGraphicsView::ScrollHandDrag);
+    setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
+    setResizeAnchor(QGraphicsView::AnchorViewCenter);
+
+    // Перерисовывается только изменившаяся часть, состояние художника
+    // между элементами не сохраняется
+    setViewportUpdateMode(QGraphicsView::SmartViewportUpdate);
+    setOptimizationFlags(QGraphicsView::DontSavePainterState | QGraphicsView::DontAdjustForAntialiasing);
+    setCacheMode(QGraphicsView::CacheBackground);
+}
+
+void GraphView::fitScene() {
+    autoFit = true;
+    fitInView(sceneRect(), Qt::KeepAspectRatio);
+    emit scaleChanged(currentScale());
+}
+
+double GraphView::currentScale() const {
+    return transform().m11();
+}
+
+void GraphView::wheelEvent(QWheelEvent* event) {
+    double steps = event->angleDelta().y() / 120.0;
+    if (steps == 0.0) {
+        QGraphicsView::wheelEvent(event);
+        return;
+    }
+
+    autoFit = false;
+    double factor = std::pow(ZoomStep, steps);
+    scale(factor, factor);
+    emit scaleChanged(currentScale());
+    event->accept();
+}
+
+void GraphView::mouseDoubleClickEvent(QMouseEvent* event) {
+    if (event->button() == Qt::LeftButton) {
+        fitScene();
+        event->accept();
+        return;
+    }
+    QGraphicsView::mouseDoubleClickEvent(event);
+}
+
+void GraphView::resizeEvent(QResizeEvent* event) {
+    QGraphicsView::resizeEvent(event);
+
+    if (autoFit) {
+        fitScene();
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef GRAPHVIEW_H
+#define GRAPHVIEW_H
+
+#include <QGraphicsView>
+
+// Вид графа с масштабированием колесом мыши и перетаскиванием.
+// Двойной щелчок возвращает вид ко всему графу.
+class GraphView : public QGraphicsView {
+    Q_OBJECT
+
+public:
+    explicit GraphView(QGraphicsScene* scene, QWidget* parent = nullptr);
+
+    // Показать всю сцену и следить за размером окна до следующего масштабирования
+    void fitScene();
+
+    // Текущий масштаб (пикселей на единицу сцены)
+    double currentScale() const;
+
+signals:
+    void scaleChanged(double scale);
+
+protected:
+    void wheelEvent(QWheelEvent* event) override;
+    void mouseDoubleClickEvent(QMouseEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+
+private:
+    bool autoFit;    // Вид подгоняется под сцену при изменении размера окна
+};
+
+#endif // GRAPHVIEW_H
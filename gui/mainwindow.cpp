@@ -0,0 +1,1101 @@
+#include "mainwindow.h"
+#include <QMessageBox>
+#include <QFileDialog>
+#include <QFileInfo>
+#include "checkpoint.h"
+#include "configfile.h"
+#include "tsplib.h"
+#include <thread>
+
+namespace {
+
+// Режимы отображения феромонов в выпадающем списке
+enum EdgeModeChoice {
+    EdgeModeAuto,
+    EdgeModeAll,
+    EdgeModeTop,
+    EdgeModeHeatMap
+};
+
+// Границы автоматического выбора режима и полной матрицы феромонов
+const size_t AllEdgesVertices = 300;
+const size_t LargeGraphVertices = 2000;
+const int AllEdgesMatrixLimit = 1000;
+
+// Причина завершения для сообщения пользователю
+QString terminationText(TerminationReason reason) {
+    switch (reason) {
+    case TerminationReason::TimeLimit: return "исчерпан лимит времени";
+    case TerminationReason::TargetCost: return "достигнута целевая стоимость";
+    case TerminationReason::NoImprovement: return "нет улучшений";
+    default: return "выполнены все итерации";
+    }
+}
+
+} // namespace
+
+MainWindow::MainWindow(QWidget *parent)
+    : QMainWindow(parent), colony(nullptr), islands(nullptr), runner(nullptr),
+    replay(nullptr), viewMatrixLimit(0), viewEdgesPerVertex(4), finishedShown(false)
+{
+    setupUI();
+    setupConnections();
+
+    // Таймер обновления экрана: решатель работает в своём потоке,
+    // интерфейс забирает последний снимок с частотой отображения
+    displayTimer = new QTimer(this);
+    connect(displayTimer, &QTimer::timeout, this, &MainWindow::onDisplayTick);
+    displayTimer->start(33);
+}
+
+MainWindow::~MainWindow() {
+    destroyColony();
+}
+
+void MainWindow::setupUI() {
+    // Центральный виджет
+    QWidget* centralWidget = new QWidget(this);
+    setCentralWidget(centralWidget);
+
+    QHBoxLayout* mainLayout = new QHBoxLayout(centralWidget);
+
+    // === Левая панель с параметрами ===
+    QVBoxLayout* leftLayout = new QVBoxLayout();
+
+    // Группа параметров графа
+    QGroupBox* graphGroup = new QGroupBox("Параметры графа");
+    QVBoxLayout* graphLayout = new QVBoxLayout();
+
+    QHBoxLayout* verticesLayout = new QHBoxLayout();
+    verticesLayout->addWidget(new QLabel("Количество вершин:"));
+    spinVertices = new QSpinBox();
+    spinVertices->setRange(5, 1000);
+    spinVertices->setValue(10);
+    verticesLayout->addWidget(spinVertices);
+    graphLayout->addLayout(verticesLayout);
+
+    btnGenerate = new QPushButton("Сгенерировать граф");
+    graphLayout->addWidget(btnGenerate);
+
+    btnLoad = new QPushButton("Загрузить TSPLIB...");
+    graphLayout->addWidget(btnLoad);
+
+    btnResume = new QPushButton("Продолжить из файла...");
+    graphLayout->addWidget(btnResume);
+
+    btnOpenTrace = new QPushButton("Открыть трассу...");
+    graphLayout->addWidget(btnOpenTrace);
+
+    graphGroup->setLayout(graphLayout);
+    leftLayout->addWidget(graphGroup);
+
+    // Группа параметров алгоритма
+    QGroupBox* algoGroup = new QGroupBox("Параметры алгоритма");
+    QVBoxLayout* algoLayout = new QVBoxLayout();
+
+    QHBoxLayout* antsLayout = new QHBoxLayout();
+    antsLayout->addWidget(new QLabel("Количество муравьёв:"));
+    spinAnts = new QSpinBox();
+    spinAnts->setRange(5, 100);
+    spinAnts->setValue(20);
+    antsLayout->addWidget(spinAnts);
+    algoLayout->addLayout(antsLayout);
+
+    QHBoxLayout* iterLayout = new QHBoxLayout();
+    iterLayout->addWidget(new QLabel("Количество итераций:"));
+    spinIterations = new QSpinBox();
+    spinIterations->setRange(10, 1000000);
+    spinIterations->setValue(100);
+    iterLayout->addWidget(spinIterations);
+    algoLayout->addLayout(iterLayout);
+
+    QHBoxLayout* alphaLayout = new QHBoxLayout();
+    alphaLayout->addWidget(new QLabel("Alpha (влияние феромона):"));
+    spinAlpha = new QDoubleSpinBox();
+    spinAlpha->setRange(0.1, 5.0);
+    spinAlpha->setValue(1.0);
+    spinAlpha->setSingleStep(0.1);
+    alphaLayout->addWidget(spinAlpha);
+    algoLayout->addLayout(alphaLayout);
+
+    QHBoxLayout* betaLayout = new QHBoxLayout();
+    betaLayout->addWidget(new QLabel("Beta (влияние эвристики):"));
+    spinBeta = new QDoubleSpinBox();
+    spinBeta->setRange(0.1, 10.0);
+    spinBeta->setValue(2.0);
+    spinBeta->setSingleStep(0.1);
+    betaLayout->addWidget(spinBeta);
+    algoLayout->addLayout(betaLayout);
+
+    QHBoxLayout* rhoLayout = new QHBoxLayout();
+    rhoLayout->addWidget(new QLabel("Rho (испарение феромона):"));
+    spinRho = new QDoubleSpinBox();
+    spinRho->setRange(0.01, 0.99);
+    spinRho->setValue(0.5);
+    spinRho->setSingleStep(0.05);
+    rhoLayout->addWidget(spinRho);
+    algoLayout->addLayout(rhoLayout);
+
+    QHBoxLayout* qLayout = new QHBoxLayout();
+    qLayout->addWidget(new QLabel("Q (константа феромона):"));
+    spinQ = new QDoubleSpinBox();
+    spinQ->setRange(1.0, 1000.0);
+    spinQ->setValue(100.0);
+    spinQ->setSingleStep(10.0);
+    qLayout->addWidget(spinQ);
+    algoLayout->addLayout(qLayout);
+
+    QHBoxLayout* candidatesLayout = new QHBoxLayout();
+    candidatesLayout->addWidget(new QLabel("Кандидаты (k ближайших, 0 - все):"));
+    spinCandidates = new QSpinBox();
+    spinCandidates->setRange(0, 100);
+    spinCandidates->setValue(15);
+    candidatesLayout->addWidget(spinCandidates);
+    algoLayout->addLayout(candidatesLayout);
+
+    QHBoxLayout* localSearchLayout = new QHBoxLayout();
+    localSearchLayout->addWidget(new QLabel("Локальный поиск (2-opt, Or-opt):"));
+    comboLocalSearch = new QComboBox();
+    comboLocalSearch->addItem("Нет", static_cast<int>(LocalSearchMode::None));
+    comboLocalSearch->addItem("Лучший муравей итерации", static_cast<int>(LocalSearchMode::IterationBest));
+    comboLocalSearch->addItem("Все муравьи", static_cast<int>(LocalSearchMode::AllAnts));
+    localSearchLayout->addWidget(comboLocalSearch);
+    algoLayout->addLayout(localSearchLayout);
+
+    QHBoxLayout* storageLayout = new QHBoxLayout();
+    storageLayout->addWidget(new QLabel("Хранение матриц:"));
+    comboStorage = new QComboBox();
+    comboStorage->addItem("Полное (double)", static_cast<int>(StorageMode::Dense));
+    comboStorage->addItem("Компактное (треугольник, float)", static_cast<int>(StorageMode::Compact));
+    storageLayout->addWidget(comboStorage);
+    algoLayout->addLayout(storageLayout);
+
+    QHBoxLayout* threadsLayout = new QHBoxLayout();
+    threadsLayout->addWidget(new QLabel("Количество потоков:"));
+    spinThreads = new QSpinBox();
+    int hardwareThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    spinThreads->setRange(1, hardwareThreads);
+    spinThreads->setValue(hardwareThreads);
+    threadsLayout->addWidget(spinThreads);
+    algoLayout->addLayout(threadsLayout);
+
+    QHBoxLayout* islandsLayout = new QHBoxLayout();
+    islandsLayout->addWidget(new QLabel("Острова (колонии):"));
+    spinIslands = new QSpinBox();
+    spinIslands->setRange(1, 16);
+    spinIslands->setValue(1);
+    islandsLayout->addWidget(spinIslands);
+    algoLayout->addLayout(islandsLayout);
+
+    QHBoxLayout* migrationLayout = new QHBoxLayout();
+    migrationLayout->addWidget(new QLabel("Обмен:"));
+    comboMigration = new QComboBox();
+    comboMigration->addItem("Кольцо", static_cast<int>(MigrationScheme::Ring));
+    comboMigration->addItem("Лучший всем", static_cast<int>(MigrationScheme::FullyConnected));
+    comboMigration->addItem("Смешивание феромонов", static_cast<int>(MigrationScheme::MergePheromone));
+    migrationLayout->addWidget(comboMigration);
+    migrationLayout->addWidget(new QLabel("каждые"));
+    spinMigrationInterval = new QSpinBox();
+    spinMigrationInterval->setRange(0, 1000);
+    spinMigrationInterval->setValue(20);
+    migrationLayout->addWidget(spinMigrationInterval);
+    algoLayout->addLayout(migrationLayout);
+
+    QHBoxLayout* timeLimitLayout = new QHBoxLayout();
+    timeLimitLayout->addWidget(new QLabel("Лимит времени, с (0 - нет):"));
+    spinTimeLimit = new QDoubleSpinBox();
+    spinTimeLimit->setRange(0.0, 86400.0);
+    spinTimeLimit->setValue(0.0);
+    spinTimeLimit->setSingleStep(1.0);
+    timeLimitLayout->addWidget(spinTimeLimit);
+    algoLayout->addLayout(timeLimitLayout);
+
+    QHBoxLayout* stallLayout = new QHBoxLayout();
+    stallLayout->addWidget(new QLabel("Стоп без улучшений, итераций (0 - нет):"));
+    spinStallIterations = new QSpinBox();
+    spinStallIterations->setRange(0, 1000000);
+    spinStallIterations->setValue(0);
+    stallLayout->addWidget(spinStallIterations);
+    algoLayout->addLayout(stallLayout);
+
+    QHBoxLayout* restartLayout = new QHBoxLayout();
+    restartLayout->addWidget(new QLabel("Перезапуск при λ-ветвлении ниже (0 - нет):"));
+    spinRestartBranching = new QDoubleSpinBox();
+    spinRestartBranching->setRange(0.0, 10.0);
+    spinRestartBranching->setValue(0.0);
+    spinRestartBranching->setSingleStep(0.05);
+    restartLayout->addWidget(spinRestartBranching);
+    algoLayout->addLayout(restartLayout);
+
+    btnLoadSettings = new QPushButton("Загрузить настройки...");
+    algoLayout->addWidget(btnLoadSettings);
+
+    algoGroup->setLayout(algoLayout);
+    leftLayout->addWidget(algoGroup);
+
+    // Группа варианта алгоритма
+    QGroupBox* variantGroup = new QGroupBox("Вариант алгоритма");
+    QVBoxLayout* variantLayout = new QVBoxLayout();
+
+    comboVariant = new QComboBox();
+    comboVariant->addItem("Ant System", static_cast<int>(AcoVariant::AntSystem));
+    comboVariant->addItem("Элитная AS", static_cast<int>(AcoVariant::ElitistAntSystem));
+    comboVariant->addItem("AS с рангами", static_cast<int>(AcoVariant::RankBasedAntSystem));
+    comboVariant->addItem("MAX-MIN Ant System", static_cast<int>(AcoVariant::MaxMinAntSystem));
+    comboVariant->addItem("Ant Colony System", static_cast<int>(AcoVariant::AntColonySystem));
+    variantLayout->addWidget(comboVariant);
+
+    VariantParameters defaults;
+    stackVariant = new QStackedWidget();
+
+    // Ant System: без дополнительных параметров
+    stackVariant->addWidget(new QLabel("Все муравьи откладывают Q / L"));
+
+    // Элитная AS
+    QWidget* elitistPage = new QWidget();
+    QHBoxLayout* elitistLayout = new QHBoxLayout(elitistPage);
+    elitistLayout->setContentsMargins(0, 0, 0, 0);
+    elitistLayout->addWidget(new QLabel("Вес лучшего маршрута (e):"));
+    spinElitistWeight = new QDoubleSpinBox();
+    spinElitistWeight->setRange(0.0, 100.0);
+    spinElitistWeight->setValue(defaults.elitistWeight);
+    elitistLayout->addWidget(spinElitistWeight);
+    stackVariant->addWidget(elitistPage);
+
+    // AS с рангами
+    QWidget* rankPage = new QWidget();
+    QHBoxLayout* rankLayout = new QHBoxLayout(rankPage);
+    rankLayout->setContentsMargins(0, 0, 0, 0);
+    rankLayout->addWidget(new QLabel("Количество рангов (w):"));
+    spinRankedAnts = new QSpinBox();
+    spinRankedAnts->setRange(1, 100);
+    spinRankedAnts->setValue(defaults.rankedAnts);
+    rankLayout->addWidget(spinRankedAnts);
+    stackVariant->addWidget(rankPage);
+
+    // MMAS
+    QWidget* mmasPage = new QWidget();
+    QVBoxLayout* mmasLayout = new QVBoxLayout(mmasPage);
+    mmasLayout->setContentsMargins(0, 0, 0, 0);
+
+    QHBoxLayout* mmasDepositLayout = new QHBoxLayout();
+    mmasDepositLayout->addWidget(new QLabel("Откладывает:"));
+    comboMmasDeposit = new QComboBox();
+    comboMmasDeposit->addItem("Лучший в итерации");
+    comboMmasDeposit->addItem("Лучший найденный");
+    comboMmasDeposit->setCurrentIndex(defaults.mmasGlobalBest ? 1 : 0);
+    mmasDepositLayout->addWidget(comboMmasDeposit);
+    mmasLayout->addLayout(mmasDepositLayout);
+
+    QHBoxLayout* mmasPBestLayout = new QHBoxLayout();
+    mmasPBestLayout->addWidget(new QLabel("pBest (задаёт τmin):"));
+    spinMmasPBest = new QDoubleSpinBox();
+    spinMmasPBest->setDecimals(3);
+    spinMmasPBest->setRange(0.001, 0.999);
+    spinMmasPBest->setSingleStep(0.01);
+    spinMmasPBest->setValue(defaults.mmasPBest);
+    mmasPBestLayout->addWidget(spinMmasPBest);
+    mmasLayout->addLayout(mmasPBestLayout);
+
+    QHBoxLayout* mmasRestartLayout = new QHBoxLayout();
+    mmasRestartLayout->addWidget(new QLabel("Переинициализация (итераций, 0 - нет):"));
+    spinMmasRestart = new QSpinBox();
+    spinMmasRestart->setRange(0, 10000);
+    spinMmasRestart->setValue(defaults.mmasRestartIterations);
+    mmasRestartLayout->addWidget(spinMmasRestart);
+    mmasLayout->addLayout(mmasRestartLayout);
+    stackVariant->addWidget(mmasPage);
+
+    // ACS
+    QWidget* acsPage = new QWidget();
+    QVBoxLayout* acsLayout = new QVBoxLayout(acsPage);
+    acsLayout->setContentsMargins(0, 0, 0, 0);
+
+    QHBoxLayout* acsQ0Layout = new QHBoxLayout();
+    acsQ0Layout->addWidget(new QLabel("q0 (выбор лучшего ребра):"));
+    spinAcsQ0 = new QDoubleSpinBox();
+    spinAcsQ0->setRange(0.0, 1.0);
+    spinAcsQ0->setSingleStep(0.05);
+    spinAcsQ0->setValue(defaults.acsQ0);
+    acsQ0Layout->addWidget(spinAcsQ0);
+    acsLayout->addLayout(acsQ0Layout);
+
+    QHBoxLayout* acsXiLayout = new QHBoxLayout();
+    acsXiLayout->addWidget(new QLabel("ξ (локальное обновление):"));
+    spinAcsXi = new QDoubleSpinBox();
+    spinAcsXi->setRange(0.0, 1.0);
+    spinAcsXi->setSingleStep(0.05);
+    spinAcsXi->setValue(defaults.acsXi);
+    acsXiLayout->addWidget(spinAcsXi);
+    acsLayout->addLayout(acsXiLayout);
+    stackVariant->addWidget(acsPage);
+
+    variantLayout->addWidget(stackVariant);
+    variantGroup->setLayout(variantLayout);
+    leftLayout->addWidget(variantGroup);
+
+    // Группа управления
+    QGroupBox* controlGroup = new QGroupBox("Управление");
+    QVBoxLayout* controlLayout = new QVBoxLayout();
+
+    btnStart = new QPushButton("Запустить алгоритм");
+    btnStart->setEnabled(false);
+    btnStart->setStyleSheet("QPushButton { background-color: #4CAF50; color: white; font-weight: bold; padding: 8px; }");
+    controlLayout->addWidget(btnStart);
+
+    btnStop = new QPushButton("Остановить");
+    btnStop->setEnabled(false);
+    btnStop->setStyleSheet("QPushButton { background-color: #f44336; color: white; font-weight: bold; padding: 8px; }");
+    controlLayout->addWidget(btnStop);
+
+    btnReset = new QPushButton("Сбросить");
+    btnReset->setEnabled(false);
+    controlLayout->addWidget(btnReset);
+
+    // Состояние сохраняется в потоке решателя при остановке и каждые N итераций
+    QHBoxLayout* checkpointLayout = new QHBoxLayout();
+    checkCheckpoint = new QCheckBox("Сохранять состояние каждые");
+    checkpointLayout->addWidget(checkCheckpoint);
+    spinCheckpointInterval = new QSpinBox();
+    spinCheckpointInterval->setRange(1, 100000);
+    spinCheckpointInterval->setValue(100);
+    checkpointLayout->addWidget(spinCheckpointInterval);
+    checkpointLayout->addWidget(new QLabel("итераций"));
+    controlLayout->addLayout(checkpointLayout);
+
+    checkTrace = new QCheckBox("Записывать трассу для воспроизведения");
+    controlLayout->addWidget(checkTrace);
+
+    controlGroup->setLayout(controlLayout);
+    leftLayout->addWidget(controlGroup);
+
+    // Группа скорости анимации
+    QGroupBox* speedGroup = new QGroupBox("Скорость анимации");
+    QVBoxLayout* speedLayout = new QVBoxLayout();
+
+    QHBoxLayout* sliderLayout = new QHBoxLayout();
+    sliderLayout->addWidget(new QLabel("Медленно"));
+    sliderSpeed = new QSlider(Qt::Horizontal);
+    sliderSpeed->setRange(1, 10);
+    sliderSpeed->setValue(5);
+    sliderLayout->addWidget(sliderSpeed);
+    sliderLayout->addWidget(new QLabel("Быстро"));
+    speedLayout->addLayout(sliderLayout);
+
+    speedGroup->setLayout(speedLayout);
+    leftLayout->addWidget(speedGroup);
+
+    // Группа опций отображения
+    QGroupBox* displayGroup = new QGroupBox("Опции отображения");
+    QVBoxLayout* displayLayout = new QVBoxLayout();
+
+    checkShowAllEdges = new QCheckBox("Показать все рёбра (феромоны)");
+    checkShowAllEdges->setChecked(true);
+    displayLayout->addWidget(checkShowAllEdges);
+
+    checkShowBestRoute = new QCheckBox("Показать лучший маршрут");
+    checkShowBestRoute->setChecked(true);
+    displayLayout->addWidget(checkShowBestRoute);
+
+    QHBoxLayout* edgeModeLayout = new QHBoxLayout();
+    edgeModeLayout->addWidget(new QLabel("Феромоны:"));
+    comboEdgeMode = new QComboBox();
+    comboEdgeMode->addItem("Авто", EdgeModeAuto);
+    comboEdgeMode->addItem("Все рёбра", EdgeModeAll);
+    comboEdgeMode->addItem("Лучшие рёбра вершин", EdgeModeTop);
+    comboEdgeMode->addItem("Тепловая карта", EdgeModeHeatMap);
+    edgeModeLayout->addWidget(comboEdgeMode);
+    displayLayout->addLayout(edgeModeLayout);
+
+    displayGroup->setLayout(displayLayout);
+    leftLayout->addWidget(displayGroup);
+
+    // Группа статистики
+    QGroupBox* statsGroup = new QGroupBox("Статистика");
+    QVBoxLayout* statsLayout = new QVBoxLayout();
+
+    labelIteration = new QLabel("Итерация: 0 / 0");
+    labelIteration->setStyleSheet("font-weight: bold; font-size: 12px;");
+    statsLayout->addWidget(labelIteration);
+
+    labelBestCost = new QLabel("Лучшая стоимость: -");
+    labelBestCost->setStyleSheet("font-weight: bold; font-size: 12px; color: #4CAF50;");
+    statsLayout->addWidget(labelBestCost);
+
+    labelStatus = new QLabel("Статус: Ожидание");
+    labelStatus->setStyleSheet("font-size: 11px; color: #666;");
+    statsLayout->addWidget(labelStatus);
+
+    statsGroup->setLayout(statsLayout);
+    leftLayout->addWidget(statsGroup);
+
+    // Группа динамики: график статистики последних итераций
+    QGroupBox* plotGroup = new QGroupBox("Динамика итераций");
+    QVBoxLayout* plotLayout = new QVBoxLayout();
+
+    QHBoxLayout* plotOptionsLayout = new QHBoxLayout();
+    checkStatistics = new QCheckBox("Собирать");
+    plotOptionsLayout->addWidget(checkStatistics);
+    comboStatistics = new QComboBox();
+    comboStatistics->addItem("Стоимость маршрутов", StatisticsPlot::MetricCost);
+    comboStatistics->addItem("Время этапов, мс", StatisticsPlot::MetricPhases);
+    comboStatistics->addItem("λ-ветвление", StatisticsPlot::MetricBranching);
+    comboStatistics->addItem("Энтропия феромона", StatisticsPlot::MetricEntropy);
+    plotOptionsLayout->addWidget(comboStatistics);
+    plotLayout->addLayout(plotOptionsLayout);
+
+    statisticsPlot = new StatisticsPlot();
+    plotLayout->addWidget(statisticsPlot);
+
+    labelConvergence = new QLabel("λ-ветвление: -, энтропия: -");
+    labelConvergence->setStyleSheet("font-size: 11px; color: #666;");
+    plotLayout->addWidget(labelConvergence);
+
+    plotGroup->setLayout(plotLayout);
+    leftLayout->addWidget(plotGroup);
+
+    leftLayout->addStretch();
+
+    // === Правая панель с визуализацией ===
+    QVBoxLayout* rightLayout = new QVBoxLayout();
+
+    QLabel* titleLabel = new QLabel("Визуализация графа и маршрута");
+    titleLabel->setStyleSheet("font-size: 16px; font-weight: bold; padding: 10px;");
+    titleLabel->setAlignment(Qt::AlignCenter);
+    rightLayout->addWidget(titleLabel);
+
+    // Графическая сцена
+    scene = new GraphScene(this);
+    graphicsView = new GraphView(scene);
+    graphicsView->setRenderHint(QPainter::Antialiasing);
+    graphicsView->setMinimumSize(800, 600);
+    rightLayout->addWidget(graphicsView);
+
+    // Шкала воспроизведения трассы (видна только в режиме воспроизведения)
+    replayGroup = new QGroupBox("Воспроизведение трассы");
+    QHBoxLayout* replayLayout = new QHBoxLayout();
+    sliderTimeline = new QSlider(Qt::Horizontal);
+    replayLayout->addWidget(sliderTimeline);
+    labelTimeline = new QLabel();
+    labelTimeline->setMinimumWidth(160);
+    replayLayout->addWidget(labelTimeline);
+    replayGroup->setLayout(replayLayout);
+    replayGroup->setVisible(false);
+    rightLayout->addWidget(replayGroup);
+
+    // Легенда
+    QGroupBox* legendGroup = new QGroupBox("Легенда");
+    QHBoxLayout* legendLayout = new QHBoxLayout();
+
+    QLabel* legendVertex = new QLabel("● Вершина (номер / стоимость)");
+    legendVertex->setStyleSheet("color: #6496FF; font-weight: bold;");
+    legendLayout->addWidget(legendVertex);
+
+    QLabel* legendPheromone = new QLabel("━ Феромон (синий=мало, красный=много)");
+    legendLayout->addWidget(legendPheromone);
+
+    QLabel* legendBest = new QLabel("━ Лучший маршрут");
+    legendBest->setStyleSheet("color: #00C800; font-weight: bold;");
+    legendLayout->addWidget(legendBest);
+
+    legendGroup->setLayout(legendLayout);
+    rightLayout->addWidget(legendGroup);
+
+    // Добавление панелей в основной layout
+    mainLayout->addLayout(leftLayout, 1);
+    mainLayout->addLayout(rightLayout, 3);
+}
+
+void MainWindow::setupConnections() {
+    connect(btnGenerate, &QPushButton::clicked, this, &MainWindow::onGenerateGraph);
+    connect(btnLoad, &QPushButton::clicked, this, &MainWindow::onLoadInstance);
+    connect(btnResume, &QPushButton::clicked, this, &MainWindow::onResumeCheckpoint);
+    connect(btnLoadSettings, &QPushButton::clicked, this, &MainWindow::onLoadSettings);
+    connect(checkCheckpoint, &QCheckBox::toggled, this, &MainWindow::onCheckpointChanged);
+    connect(checkTrace, &QCheckBox::toggled, this, &MainWindow::onTraceChanged);
+    connect(btnOpenTrace, &QPushButton::clicked, this, &MainWindow::onOpenTrace);
+    connect(sliderTimeline, &QSlider::valueChanged, this, &MainWindow::onTimelineChanged);
+    connect(spinCheckpointInterval, QOverload<int>::of(&QSpinBox::valueChanged),
+            this, &MainWindow::onCheckpointChanged);
+    connect(btnStart, &QPushButton::clicked, this, &MainWindow::onStartAlgorithm);
+    connect(btnStop, &QPushButton::clicked, this, &MainWindow::onStopAlgorithm);
+    connect(btnReset, &QPushButton::clicked, this, &MainWindow::onResetAlgorithm);
+    connect(sliderSpeed, &QSlider::valueChanged, this, &MainWindow::onSpeedChanged);
+
+    connect(checkShowAllEdges, &QCheckBox::stateChanged, [this]() {
+        updateVisualization();
+    });
+
+    connect(checkShowBestRoute, &QCheckBox::stateChanged, [this]() {
+        updateVisualization();
+    });
+
+    connect(comboVariant, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            stackVariant, &QStackedWidget::setCurrentIndex);
+
+    connect(comboEdgeMode, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &MainWindow::onEdgeModeChanged);
+
+    connect(checkStatistics, &QCheckBox::toggled, this, &MainWindow::onStatisticsChanged);
+    connect(comboStatistics, QOverload<int>::of(&QComboBox::currentIndexChanged), [this]() {
+        statisticsPlot->setMetric(static_cast<StatisticsPlot::Metric>(comboStatistics->currentData().toInt()));
+    });
+
+    // Подписи вершин зависят от масштаба вида
+    connect(graphicsView, &GraphView::scaleChanged, scene, &GraphScene::setViewScale);
+}
+
+void MainWindow::destroyColony() {
+    // Поток решателя останавливается до удаления колонии
+    delete runner;
+    runner = nullptr;
+    closeReplay();
+    currentSnapshot = ColonySnapshot();
+
+    // Острова владеют своими колониями
+    if (islands) {
+        delete islands;
+    } else {
+        delete colony;
+    }
+    islands = nullptr;
+    colony = nullptr;
+}
+
+void MainWindow::createColony(int numVertices) {
+    // Создание нового алгоритма с заданными параметрами
+    destroyColony();
+
+    int numAnts = spinAnts->value();
+    double alpha = spinAlpha->value();
+    double beta = spinBeta->value();
+    double rho = spinRho->value();
+    double Q = spinQ->value();
+    int maxIterations = spinIterations->value();
+
+    StorageMode storage = static_cast<StorageMode>(comboStorage->currentData().toInt());
+
+    if (spinIslands->value() == 1) {
+        colony = new AntColony(numVertices, numAnts, alpha, beta, rho, Q, maxIterations);
+        colony->setStorageMode(storage);
+        return;
+    }
+
+    islands = new IslandModel();
+    for (int i = 0; i < spinIslands->value(); ++i) {
+        std::unique_ptr<AntColony> island(new AntColony(numVertices, numAnts, alpha, beta, rho, Q, maxIterations));
+        island->setStorageMode(storage);
+        islands->addIsland(std::move(island));
+    }
+    islands->setMigration(static_cast<MigrationScheme>(comboMigration->currentData().toInt()),
+                          spinMigrationInterval->value());
+    colony = &islands->getIsland(0);
+}
+
+void MainWindow::configureColonies() {
+    // Потоки делятся между островами
+    int count = islands ? islands->getIslandCount() : 1;
+    for (int i = 0; i < count; ++i) {
+        AntColony& target = islands ? islands->getIsland(i) : *colony;
+        target.setCandidateListSize(spinCandidates->value());
+        target.setThreadCount(std::max(1, spinThreads->value() / count));
+        target.setLocalSearch(static_cast<LocalSearchMode>(comboLocalSearch->currentData().toInt()));
+        target.setVariant(static_cast<AcoVariant>(comboVariant->currentData().toInt()), variantParameters());
+    }
+}
+
+void MainWindow::configureTermination() {
+    // Условия остановки проверяются по лучшему маршруту модели, перезапуски - на каждом острове
+    TerminationCriteria criteria;
+    criteria.timeLimitMs = static_cast<int>(spinTimeLimit->value() * 1000.0);
+    criteria.stallIterations = spinStallIterations->value();
+
+    RestartParameters restart;
+    restart.minBranching = spinRestartBranching->value();
+
+    if (islands) {
+        islands->setTermination(criteria);
+        for (int i = 0; i < islands->getIslandCount(); ++i) {
+            islands->getIsland(i).setRestart(restart);
+        }
+    } else {
+        colony->setTermination(criteria);
+        colony->setRestart(restart);
+    }
+}
+
+void MainWindow::onGraphReady(const QString& message) {
+    // С этого момента колонией владеет поток решателя
+    configureTermination();
+    graphVertices = colony->getVertices();
+    runner = islands ? new SolverRunner(islands) : new SolverRunner(colony);
+    runner->setIterationDelay(iterationDelay());
+    applyCheckpoint();
+    applyTrace();
+    applyStatistics();
+    runner->poll();
+    currentSnapshot = runner->snapshot();
+    finishedShown = false;
+
+    // Обновление UI
+    btnStart->setEnabled(true);
+    btnReset->setEnabled(true);
+    labelStatus->setText("Статус: Граф сгенерирован");
+
+    scene->setGraph(graphVertices);
+    applyEdgeMode();
+    graphicsView->setRenderHint(QPainter::Antialiasing, graphVertices.size() <= LargeGraphVertices);
+    graphicsView->fitScene();
+    updateStatistics();
+    updateVisualization();
+
+    QMessageBox::information(this, "Успех", message);
+}
+
+void MainWindow::onGenerateGraph() {
+    int numVertices = spinVertices->value();
+    createColony(numVertices);
+
+    // Генерация графа
+    QRect viewRect = graphicsView->viewport()->rect();
+    if (islands) {
+        islands->generateRandomGraph(viewRect.width() - 100, viewRect.height() - 100);
+    } else {
+        colony->generateRandomGraph(viewRect.width() - 100, viewRect.height() - 100);
+    }
+    configureColonies();
+
+    onGraphReady(QString("Граф с %1 вершинами успешно сгенерирован!").arg(numVertices));
+}
+
+void MainWindow::onLoadInstance() {
+    QString path = QFileDialog::getOpenFileName(this, "Загрузить задачу TSPLIB", QString(),
+                                                "TSPLIB (*.tsp *.atsp);;Все файлы (*)");
+    if (path.isEmpty()) {
+        return;
+    }
+
+    Instance instance;
+    std::string error;
+    if (!loadTsplib(path.toStdString(), instance, error)) {
+        QMessageBox::warning(this, "Ошибка",
+                             QString("Не удалось загрузить файл:\n%1").arg(QString::fromStdString(error)));
+        return;
+    }
+
+    createColony(static_cast<int>(instance.vertices.size()));
+    if (islands) {
+        islands->setInstance(instance);
+    } else {
+        colony->setInstance(instance);
+    }
+    configureColonies();
+
+    onGraphReady(QString("Задача %1 с %2 вершинами успешно загружена!")
+                     .arg(QString::fromStdString(instance.name))
+                     .arg(graphVertices.size()));
+}
+
+void MainWindow::onResumeCheckpoint() {
+    QString path = QFileDialog::getOpenFileName(this, "Продолжить из контрольной точки", checkpointPath,
+                                                "Контрольные точки (*.ackpt);;Все файлы (*)");
+    if (path.isEmpty()) {
+        return;
+    }
+
+    // Граф, параметры и феромоны берутся из файла; продолжается одна колония
+    destroyColony();
+    colony = new AntColony(spinVertices->value(), spinAnts->value(), spinAlpha->value(), spinBeta->value(),
+                           spinRho->value(), spinQ->value(), spinIterations->value());
+    colony->setThreadCount(spinThreads->value());
+
+    std::string error;
+    if (!loadCheckpoint(path.toStdString(), *colony, error)) {
+        destroyColony();
+        btnStart->setEnabled(false);
+        btnReset->setEnabled(false);
+        QMessageBox::warning(this, "Ошибка",
+                             QString("Не удалось загрузить состояние:\n%1").arg(QString::fromStdString(error)));
+        return;
+    }
+
+    // Дальнейшие контрольные точки пишутся в тот же файл
+    checkpointPath = path;
+    showColonySettings();
+
+    onGraphReady(QString("Состояние загружено: итерация %1 из %2")
+                     .arg(colony->getCurrentIteration())
+                     .arg(colony->getMaxIterations()));
+}
+
+void MainWindow::showColonySettings() {
+    // Поля параметров показывают настройки загруженной колонии
+    spinVertices->setValue(colony->getNumVertices());
+    spinAnts->setValue(colony->getNumAnts());
+    spinIterations->setValue(colony->getMaxIterations());
+    spinAlpha->setValue(colony->getAlpha());
+    spinBeta->setValue(colony->getBeta());
+    spinRho->setValue(colony->getRho());
+    spinQ->setValue(colony->getQ());
+    spinCandidates->setValue(colony->getCandidateListSize());
+    spinIslands->setValue(1);
+    comboLocalSearch->setCurrentIndex(comboLocalSearch->findData(static_cast<int>(colony->getLocalSearchMode())));
+    comboStorage->setCurrentIndex(comboStorage->findData(static_cast<int>(colony->getStorageMode())));
+    comboVariant->setCurrentIndex(comboVariant->findData(static_cast<int>(colony->getVariant())));
+}
+
+void MainWindow::onLoadSettings() {
+    QString path = QFileDialog::getOpenFileName(this, "Загрузить настройки", QString(),
+                                                "Настройки (*.conf);;Все файлы (*)");
+    if (path.isEmpty()) {
+        return;
+    }
+
+    std::vector<ConfigEntry> entries;
+    std::string error;
+    if (!readConfigFile(path.toStdString(), entries, error)) {
+        QMessageBox::warning(this, "Ошибка",
+                             QString("Не удалось загрузить настройки:\n%1").arg(QString::fromStdString(error)));
+        return;
+    }
+
+    // Ключи совпадают с опциями aco-solve; незнакомые ключи (например, опции
+    // без поля в интерфейсе) пропускаются и перечисляются в сообщении
+    const std::pair<const char*, AcoVariant> variants[] = {
+        { "as", AcoVariant::AntSystem }, { "elitist", AcoVariant::ElitistAntSystem },
+        { "rank", AcoVariant::RankBasedAntSystem }, { "mmas", AcoVariant::MaxMinAntSystem },
+        { "acs", AcoVariant::AntColonySystem }
+    };
+    const std::pair<const char*, LocalSearchMode> localSearchModes[] = {
+        { "none", LocalSearchMode::None }, { "best", LocalSearchMode::IterationBest },
+        { "all", LocalSearchMode::AllAnts }
+    };
+
+    QStringList skipped;
+    for (const ConfigEntry& entry : entries) {
+        QString value = QString::fromStdString(entry.value);
+        if (entry.key == "ants") spinAnts->setValue(value.toInt());
+        else if (entry.key == "iterations") spinIterations->setValue(value.toInt());
+        else if (entry.key == "alpha") spinAlpha->setValue(value.toDouble());
+        else if (entry.key == "beta") spinBeta->setValue(value.toDouble());
+        else if (entry.key == "rho") spinRho->setValue(value.toDouble());
+        else if (entry.key == "q") spinQ->setValue(value.toDouble());
+        else if (entry.key == "candidates") spinCandidates->setValue(value.toInt());
+        else if (entry.key == "variant") {
+            for (const auto& variant : variants) {
+                if (entry.value == variant.first) {
+                    comboVariant->setCurrentIndex(comboVariant->findData(static_cast<int>(variant.second)));
+                }
+            }
+        }
+        else if (entry.key == "local-search") {
+            for (const auto& mode : localSearchModes) {
+                if (entry.value == mode.first) {
+                    comboLocalSearch->setCurrentIndex(comboLocalSearch->findData(static_cast<int>(mode.second)));
+                }
+            }
+        }
+        else {
+            skipped << QString::fromStdString(entry.key);
+        }
+    }
+
+    QString message = QString("Статус: Настройки загружены из %1").arg(QFileInfo(path).fileName());
+    if (!skipped.isEmpty()) {
+        message += QString(" (пропущены: %1)").arg(skipped.join(", "));
+    }
+    labelStatus->setText(message);
+}
+
+void MainWindow::onCheckpointChanged() {
+    if (checkCheckpoint->isChecked() && checkpointPath.isEmpty()) {
+        checkpointPath = QFileDialog::getSaveFileName(this, "Файл контрольных точек", "colony.ackpt",
+                                                      "Контрольные точки (*.ackpt);;Все файлы (*)");
+        if (checkpointPath.isEmpty()) {
+            checkCheckpoint->setChecked(false);
+            return;
+        }
+    }
+    applyCheckpoint();
+}
+
+void MainWindow::applyCheckpoint() {
+    if (!runner) return;
+
+    if (checkCheckpoint->isChecked() && !checkpointPath.isEmpty()) {
+        runner->setCheckpoint(checkpointPath.toStdString(), spinCheckpointInterval->value(), 0);
+    } else {
+        runner->setCheckpoint(std::string(), 0, 0);
+    }
+}
+
+void MainWindow::onTraceChanged() {
+    if (checkTrace->isChecked() && tracePath.isEmpty()) {
+        tracePath = QFileDialog::getSaveFileName(this, "Файл трассы", "run.acotrace",
+                                                 "Трассы (*.acotrace);;Все файлы (*)");
+        if (tracePath.isEmpty()) {
+            checkTrace->setChecked(false);
+            return;
+        }
+    }
+    applyTrace();
+}
+
+void MainWindow::applyTrace() {
+    if (!runner) return;
+
+    // Ключевой кадр с феромонами каждые 100 итераций
+    if (checkTrace->isChecked() && !tracePath.isEmpty()) {
+        runner->setTrace(tracePath.toStdString(), 100, true);
+    } else {
+        runner->setTrace(std::string(), 0, false);
+    }
+}
+
+void MainWindow::onStatisticsChanged() {
+    applyStatistics();
+}
+
+void MainWindow::applyStatistics() {
+    if (!runner) return;
+
+    // Снимок содержит статистику последних 500 итераций
+    runner->setStatistics(checkStatistics->isChecked());
+}
+
+void MainWindow::onOpenTrace() {
+    QString path = QFileDialog::getOpenFileName(this, "Открыть трассу", tracePath,
+                                                "Трассы (*.acotrace);;Все файлы (*)");
+    if (path.isEmpty()) {
+        return;
+    }
+
+    // Воспроизведение не требует колонии: граф и состояния берутся из файла
+    destroyColony();
+    btnStart->setEnabled(false);
+    btnStop->setEnabled(false);
+    btnReset->setEnabled(false);
+
+    replay = new TraceReader();
+    std::string error;
+    if (!replay->open(path.toStdString(), error)) {
+        closeReplay();
+        QMessageBox::warning(this, "Ошибка",
+                             QString("Не удалось открыть трассу:\n%1").arg(QString::fromStdString(error)));
+        return;
+    }
+
+    graphVertices = replay->getVertices();
+    scene->setGraph(graphVertices);
+    applyEdgeMode();
+    graphicsView->setRenderHint(QPainter::Antialiasing, graphVertices.size() <= LargeGraphVertices);
+    graphicsView->fitScene();
+
+    // Установка диапазона вызывает onTimelineChanged для первой итерации
+    replayGroup->setVisible(true);
+    sliderTimeline->setRange(replay->getFirstIteration(), replay->getLastIteration());
+    sliderTimeline->setValue(replay->getFirstIteration());
+    onTimelineChanged(sliderTimeline->value());
+    labelStatus->setText("Статус: Воспроизведение трассы");
+}
+
+void MainWindow::onTimelineChanged(int iteration) {
+    if (!replay || !replay->seek(iteration, currentSnapshot, viewMatrixLimit, viewEdgesPerVertex)) {
+        return;
+    }
+
+    labelTimeline->setText(QString("Итерация %1 / %2").arg(currentSnapshot.iteration).arg(replay->getLastIteration()));
+    updateStatistics();
+    updateVisualization();
+}
+
+void MainWindow::closeReplay() {
+    delete replay;
+    replay = nullptr;
+    replayGroup->setVisible(false);
+}
+
+void MainWindow::onStartAlgorithm() {
+    if (!runner) {
+        QMessageBox::warning(this, "Ошибка", "Сначала сгенерируйте граф!");
+        return;
+    }
+
+    btnStart->setEnabled(false);
+    btnStop->setEnabled(true);
+    btnGenerate->setEnabled(false);
+    btnLoad->setEnabled(false);
+    labelStatus->setText("Статус: Алгоритм работает...");
+
+    runner->start();
+}
+
+void MainWindow::onStopAlgorithm() {
+    if (runner) {
+        runner->stop();
+    }
+
+    btnStart->setEnabled(true);
+    btnStop->setEnabled(false);
+    btnGenerate->setEnabled(true);
+    btnLoad->setEnabled(true);
+    labelStatus->setText("Статус: Остановлено");
+}
+
+void MainWindow::onResetAlgorithm() {
+    if (!runner) return;
+
+    runner->reset();
+    finishedShown = false;
+
+    btnStart->setEnabled(true);
+    btnStop->setEnabled(false);
+    btnGenerate->setEnabled(true);
+    btnLoad->setEnabled(true);
+
+    labelStatus->setText("Статус: Алгоритм сброшен");
+}
+
+void MainWindow::onDisplayTick() {
+    if (!runner || !runner->poll()) {
+        return;
+    }
+
+    currentSnapshot = runner->snapshot();
+
+    updateStatistics();
+    updateVisualization();
+
+    if (currentSnapshot.running) {
+        labelStatus->setText(QString("Статус: Итерация %1 завершена").arg(currentSnapshot.iteration));
+    }
+
+    if (currentSnapshot.finished && !finishedShown) {
+        finishedShown = true;
+        onAlgorithmFinished();
+    }
+}
+
+void MainWindow::onAlgorithmFinished() {
+    btnStart->setEnabled(false);
+    btnStop->setEnabled(false);
+    btnGenerate->setEnabled(true);
+    btnLoad->setEnabled(true);
+
+    labelStatus->setText("Статус: Алгоритм завершён!");
+
+    QMessageBox::information(this, "Завершено",
+                             QString("Алгоритм завершён: %1\n\nЛучшая найденная стоимость: %2\nИтераций: %3\nПерезапусков: %4")
+                                 .arg(terminationText(currentSnapshot.termination))
+                                 .arg(currentSnapshot.bestCost, 0, 'f', 2)
+                                 .arg(currentSnapshot.iteration)
+                                 .arg(currentSnapshot.restarts));
+}
+
+VariantParameters MainWindow::variantParameters() const {
+    VariantParameters parameters;
+    parameters.elitistWeight = spinElitistWeight->value();
+    parameters.rankedAnts = spinRankedAnts->value();
+    parameters.mmasGlobalBest = comboMmasDeposit->currentIndex() == 1;
+    parameters.mmasPBest = spinMmasPBest->value();
+    parameters.mmasRestartIterations = spinMmasRestart->value();
+    parameters.acsQ0 = spinAcsQ0->value();
+    parameters.acsXi = spinAcsXi->value();
+    return parameters;
+}
+
+int MainWindow::iterationDelay() const {
+    // От 900 мс (медленно) до 0 мс (максимальная скорость решателя)
+    return (sliderSpeed->maximum() - sliderSpeed->value()) * 100;
+}
+
+void MainWindow::onSpeedChanged(int value) {
+    Q_UNUSED(value);
+
+    if (runner) {
+        runner->setIterationDelay(iterationDelay());
+    }
+}
+
+void MainWindow::updateStatistics() {
+    if (!runner && !replay) return;
+
+    labelIteration->setText(QString("Итерация: %1 / %2")
+                                .arg(currentSnapshot.iteration)
+                                .arg(currentSnapshot.maxIterations));
+
+    if (currentSnapshot.bestCost < std::numeric_limits<double>::max() && currentSnapshot.island >= 0) {
+        labelBestCost->setText(QString("Лучшая стоимость: %1 (остров %2)")
+                                   .arg(currentSnapshot.bestCost, 0, 'f', 2)
+                                   .arg(currentSnapshot.island + 1));
+    } else if (currentSnapshot.bestCost < std::numeric_limits<double>::max()) {
+        labelBestCost->setText(QString("Лучшая стоимость: %1")
+                                   .arg(currentSnapshot.bestCost, 0, 'f', 2));
+    } else {
+        labelBestCost->setText("Лучшая стоимость: -");
+    }
+
+    statisticsPlot->setStatistics(currentSnapshot.statistics);
+    if (!currentSnapshot.statistics.empty()) {
+        const IterationStatistics& last = currentSnapshot.statistics.back();
+        labelConvergence->setText(QString("λ-ветвление: %1, энтропия: %2, итерация: %3 мс")
+                                      .arg(last.branchingFactor, 0, 'f', 2)
+                                      .arg(last.entropy, 0, 'f', 3)
+                                      .arg(1000.0 * last.iterationSeconds, 0, 'f', 2));
+    } else {
+        labelConvergence->setText("λ-ветвление: -, энтропия: -");
+    }
+}
+
+void MainWindow::updateVisualization() {
+    if (!runner && !replay) return;
+
+    bool showAllEdges = checkShowAllEdges->isChecked();
+    bool showBestRoute = checkShowBestRoute->isChecked();
+
+    scene->updateFrame(currentSnapshot, showAllEdges, showBestRoute);
+}
+
+void MainWindow::onEdgeModeChanged() {
+    if (!runner && !replay) return;
+
+    applyEdgeMode();
+    if (replay) {
+        onTimelineChanged(sliderTimeline->value());
+    }
+    updateVisualization();
+}
+
+void MainWindow::applyEdgeMode() {
+    // В автоматическом режиме способ отображения выбирается по размеру графа:
+    // каждое ребро - до сотен вершин, лучшие рёбра - до тысяч, дальше тепловая карта
+    int mode = comboEdgeMode->currentData().toInt();
+    size_t n = graphVertices.size();
+    if (mode == EdgeModeAuto) {
+        mode = n <= AllEdgesVertices ? EdgeModeAll
+             : n <= LargeGraphVertices ? EdgeModeTop
+             : EdgeModeHeatMap;
+    }
+
+    switch (mode) {
+    case EdgeModeAll:
+        viewMatrixLimit = AllEdgesMatrixLimit;
+        viewEdgesPerVertex = 4;
+        scene->setEdgeMode(GraphScene::EdgeLines);
+        break;
+    case EdgeModeTop:
+        viewMatrixLimit = 0;
+        viewEdgesPerVertex = 4;
+        scene->setEdgeMode(GraphScene::EdgeLines);
+        break;
+    default:
+        viewMatrixLimit = 0;
+        viewEdgesPerVertex = 8;
+        scene->setEdgeMode(GraphScene::EdgeHeatMap);
+        break;
+    }
+
+    if (runner) {
+        runner->setPheromoneView(viewMatrixLimit, viewEdgesPerVertex);
+    }
+}
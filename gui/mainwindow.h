@@ -0,0 +1,159 @@
+#ifndef MAINWINDOW_H
+#define MAINWINDOW_H
+
+#include <QMainWindow>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QDoubleSpinBox>
+#include <QLabel>
+#include <QTimer>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QGroupBox>
+#include <QCheckBox>
+#include <QSlider>
+#include <QComboBox>
+#include <QStackedWidget>
+#include "antcolony.h"
+#include "islandmodel.h"
+#include "solverrunner.h"
+#include "tracelog.h"
+#include "graphscene.h"
+#include "graphview.h"
+#include "statisticsplot.h"
+
+class MainWindow : public QMainWindow {
+    Q_OBJECT
+
+public:
+    MainWindow(QWidget *parent = nullptr);
+    ~MainWindow();
+
+private slots:
+    void onGenerateGraph();
+    void onLoadInstance();
+    void onResumeCheckpoint();
+    void onLoadSettings();
+    void onCheckpointChanged();
+    void onTraceChanged();
+    void onOpenTrace();
+    void onTimelineChanged(int iteration);
+    void onStartAlgorithm();
+    void onStopAlgorithm();
+    void onResetAlgorithm();
+    void onDisplayTick();
+    void onAlgorithmFinished();
+    void onSpeedChanged(int value);
+    void onEdgeModeChanged();
+    void onStatisticsChanged();
+
+private:
+    void setupUI();
+    void setupConnections();
+    void createColony(int numVertices);
+    void destroyColony();
+    int iterationDelay() const;
+    void configureColonies();
+    void configureTermination();
+    void onGraphReady(const QString& message);
+    void showColonySettings();
+    void applyCheckpoint();
+    void applyTrace();
+    void applyStatistics();
+    void closeReplay();
+    void updateStatistics();
+    void updateVisualization();
+    void applyEdgeMode();
+    VariantParameters variantParameters() const;
+
+    // UI элементы
+    GraphView* graphicsView;
+    GraphScene* scene;
+
+    // Параметры алгоритма
+    QSpinBox* spinVertices;
+    QSpinBox* spinAnts;
+    QSpinBox* spinIterations;
+    QDoubleSpinBox* spinAlpha;
+    QDoubleSpinBox* spinBeta;
+    QDoubleSpinBox* spinRho;
+    QDoubleSpinBox* spinQ;
+    QSpinBox* spinCandidates;
+    QComboBox* comboLocalSearch;
+    QComboBox* comboStorage;
+
+    // Вариант алгоритма и его параметры (страница на каждый вариант)
+    QComboBox* comboVariant;
+    QStackedWidget* stackVariant;
+    QDoubleSpinBox* spinElitistWeight;
+    QSpinBox* spinRankedAnts;
+    QComboBox* comboMmasDeposit;
+    QDoubleSpinBox* spinMmasPBest;
+    QSpinBox* spinMmasRestart;
+    QDoubleSpinBox* spinAcsQ0;
+    QDoubleSpinBox* spinAcsXi;
+    QSpinBox* spinThreads;
+
+    // Островная модель
+    QSpinBox* spinIslands;
+    QComboBox* comboMigration;
+    QSpinBox* spinMigrationInterval;
+
+    // Досрочная остановка и перезапуски при застое
+    QDoubleSpinBox* spinTimeLimit;
+    QSpinBox* spinStallIterations;
+    QDoubleSpinBox* spinRestartBranching;
+
+    // Кнопки управления
+    QPushButton* btnGenerate;
+    QPushButton* btnLoad;
+    QPushButton* btnResume;
+    QPushButton* btnLoadSettings;
+    QPushButton* btnOpenTrace;
+    QPushButton* btnStart;
+    QPushButton* btnStop;
+    QPushButton* btnReset;
+
+    // Контрольные точки
+    QCheckBox* checkCheckpoint;
+    QSpinBox* spinCheckpointInterval;
+    QString checkpointPath;
+
+    // Запись трассы и воспроизведение
+    QCheckBox* checkTrace;
+    QString tracePath;
+    QGroupBox* replayGroup;
+    QSlider* sliderTimeline;
+    QLabel* labelTimeline;
+
+    // Опции отображения
+    QCheckBox* checkShowAllEdges;
+    QCheckBox* checkShowBestRoute;
+    QComboBox* comboEdgeMode;
+    QSlider* sliderSpeed;
+
+    // Статистика
+    QLabel* labelIteration;
+    QLabel* labelBestCost;
+    QLabel* labelStatus;
+
+    // Статистика итераций
+    QCheckBox* checkStatistics;
+    QComboBox* comboStatistics;
+    QLabel* labelConvergence;
+    StatisticsPlot* statisticsPlot;
+
+    // Алгоритм, поток решателя и таймер обновления экрана
+    AntColony* colony;                   // С островами - первый остров (для задания графа)
+    IslandModel* islands;                // nullptr для одной колонии
+    SolverRunner* runner;
+    TraceReader* replay;                 // Открытая трасса (режим воспроизведения)
+    int viewMatrixLimit;                 // Параметры представления феромонов для воспроизведения
+    int viewEdgesPerVertex;
+    QTimer* displayTimer;
+    std::vector<Vertex> graphVertices;   // Копия вершин для отрисовки
+    ColonySnapshot currentSnapshot;      // Последний отображённый снимок
+    bool finishedShown;
+};
+
+#endif // MAINWINDOW_H
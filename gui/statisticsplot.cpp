@@ -0,0 +1,127 @@
+#include "statisticsplot.h"
+#include <QPainter>
+#include <QPainterPath>
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+// Поля графика: слева - подписи шкалы, сверху - легенда
+const int MarginLeft = 60;
+const int MarginRight = 8;
+const int MarginTop = 20;
+const int MarginBottom = 18;
+
+} // namespace
+
+StatisticsPlot::StatisticsPlot(QWidget* parent)
+    : QWidget(parent), metric(MetricCost)
+{
+    setMinimumHeight(160);
+}
+
+void StatisticsPlot::setMetric(Metric value) {
+    metric = value;
+    update();
+}
+
+void StatisticsPlot::setStatistics(const std::vector<IterationStatistics>& statistics) {
+    history.assign(statistics.begin(), statistics.end());
+    update();
+}
+
+std::vector<StatisticsPlot::Series> StatisticsPlot::currentSeries() const {
+    switch (metric) {
+    case MetricCost:
+        return {
+            { "лучшая", QColor(0, 160, 0), [](const IterationStatistics& s) { return s.bestCost; } },
+            { "средняя", QColor(40, 90, 200), [](const IterationStatistics& s) { return s.meanCost; } },
+            { "мин", QColor(120, 170, 255), [](const IterationStatistics& s) { return s.minCost; } },
+            { "макс", QColor(230, 120, 60), [](const IterationStatistics& s) { return s.maxCost; } }
+        };
+    case MetricPhases:
+        return {
+            { "построение", QColor(40, 90, 200), [](const IterationStatistics& s) { return 1000.0 * s.constructionSeconds; } },
+            { "лок. поиск", QColor(150, 60, 180), [](const IterationStatistics& s) { return 1000.0 * s.localSearchSeconds; } },
+            { "испарение", QColor(230, 120, 60), [](const IterationStatistics& s) { return 1000.0 * s.evaporationSeconds; } },
+            { "откладывание", QColor(200, 40, 40), [](const IterationStatistics& s) { return 1000.0 * s.depositSeconds; } },
+            { "веса", QColor(0, 160, 0), [](const IterationStatistics& s) { return 1000.0 * s.choiceInfoSeconds; } }
+        };
+    case MetricBranching:
+        return { { "λ-ветвление", QColor(40, 90, 200), [](const IterationStatistics& s) { return s.branchingFactor; } } };
+    default:
+        return { { "энтропия", QColor(150, 60, 180), [](const IterationStatistics& s) { return s.entropy; } } };
+    }
+}
+
+void StatisticsPlot::paintEvent(QPaintEvent* event) {
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor(250, 250, 250));
+    painter.setPen(QColor(200, 200, 200));
+    painter.drawRect(rect().adjusted(0, 0, -1, -1));
+
+    QRectF area(MarginLeft, MarginTop, width() - MarginLeft - MarginRight, height() - MarginTop - MarginBottom);
+    if (history.size() < 2 || area.width() <= 0 || area.height() <= 0) {
+        painter.setPen(QColor(120, 120, 120));
+        painter.drawText(rect(), Qt::AlignCenter, "Нет данных");
+        return;
+    }
+
+    std::vector<Series> series = currentSeries();
+
+    // Общая шкала всех линий
+    double low = std::numeric_limits<double>::max();
+    double high = std::numeric_limits<double>::lowest();
+    for (const Series& line : series) {
+        for (const IterationStatistics& s : history) {
+            low = std::min(low, line.value(s));
+            high = std::max(high, line.value(s));
+        }
+    }
+    if (high - low < 1e-12) {
+        high = low + 1.0;
+    }
+
+    double firstIteration = history.front().iteration;
+    double span = std::max(1, history.back().iteration - history.front().iteration);
+    auto toPoint = [&](const IterationStatistics& s, double value) {
+        return QPointF(area.left() + (s.iteration - firstIteration) / span * area.width(),
+                       area.bottom() - (value - low) / (high - low) * area.height());
+    };
+
+    // Шкала
+    painter.setPen(QColor(220, 220, 220));
+    painter.drawLine(area.bottomLeft(), area.bottomRight());
+    painter.drawLine(area.topLeft(), area.topRight());
+    painter.setPen(QColor(90, 90, 90));
+    QFont font = painter.font();
+    font.setPointSizeF(7.5);
+    painter.setFont(font);
+    painter.drawText(QRectF(0, area.top() - 6, MarginLeft - 4, 12), Qt::AlignRight | Qt::AlignVCenter,
+                     QString::number(high, 'g', 5));
+    painter.drawText(QRectF(0, area.bottom() - 6, MarginLeft - 4, 12), Qt::AlignRight | Qt::AlignVCenter,
+                     QString::number(low, 'g', 5));
+    painter.drawText(QRectF(area.left(), area.bottom() + 2, area.width(), MarginBottom - 2),
+                     Qt::AlignLeft | Qt::AlignTop, QString::number(history.front().iteration));
+    painter.drawText(QRectF(area.left(), area.bottom() + 2, area.width(), MarginBottom - 2),
+                     Qt::AlignRight | Qt::AlignTop, QString::number(history.back().iteration));
+
+    // Линии и легенда
+    painter.setRenderHint(QPainter::Antialiasing);
+    double legendX = area.left();
+    for (const Series& line : series) {
+        QPainterPath path;
+        path.moveTo(toPoint(history.front(), line.value(history.front())));
+        for (size_t i = 1; i < history.size(); ++i) {
+            path.lineTo(toPoint(history[i], line.value(history[i])));
+        }
+        painter.setPen(QPen(line.color, 1.5));
+        painter.drawPath(path);
+
+        QString name = QString::fromUtf8(line.name);
+        painter.drawText(QPointF(legendX, MarginTop - 6), name);
+        legendX += painter.fontMetrics().horizontalAdvance(name) + 10;
+    }
+}
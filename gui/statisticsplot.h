@@ -0,0 +1,45 @@
+#ifndef STATISTICSPLOT_H
+#define STATISTICSPLOT_H
+
+#include <QColor>
+#include <QWidget>
+#include <vector>
+#include "antcolony.h"
+
+// График статистики последних итераций: несколько линий одного показателя
+// с общей шкалой по вертикали и номерами итераций по горизонтали
+class StatisticsPlot : public QWidget {
+    Q_OBJECT
+
+public:
+    // Показатель на графике
+    enum Metric {
+        MetricCost,         // Лучшая, средняя, минимальная и максимальная стоимость
+        MetricPhases,       // Время этапов итерации (мс)
+        MetricBranching,    // λ-ветвление
+        MetricEntropy       // Энтропия феромона
+    };
+
+    explicit StatisticsPlot(QWidget* parent = nullptr);
+
+    void setMetric(Metric metric);
+    void setStatistics(const std::vector<IterationStatistics>& statistics);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    // Линия графика: значение показателя итерации
+    struct Series {
+        const char* name;
+        QColor color;
+        double (*value)(const IterationStatistics&);
+    };
+
+    std::vector<Series> currentSeries() const;
+
+    Metric metric;
+    std::vector<IterationStatistics> history;
+};
+
+#endif // STATISTICSPLOT_H
@@ -0,0 +1,473 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+#include "antcolony.h"
+#include "checkpoint.h"
+#include "choicekernel.h"
+#include "islandmodel.h"
+#include "solverrunner.h"
+#include "tracelog.h"
+#include "tsplib.h"
+
+// Регрессионные проверки решателя без внешних зависимостей: каждая проверка
+// печатает неудачные условия, код возврата - количество неудачных проверок.
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            ++failures; \
+        } \
+    } while (0)
+
+bool nearlyEqual(double a, double b) {
+    return std::fabs(a - b) <= 1e-9 * std::max(1.0, std::fabs(b));
+}
+
+std::vector<Vertex> randomVertices(int n, unsigned int seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> coord(0.0, 1000.0);
+    std::uniform_real_distribution<double> cost(1.0, 50.0);
+
+    std::vector<Vertex> result;
+    for (int i = 0; i < n; ++i) {
+        result.emplace_back(i, Point(coord(rng), coord(rng)), cost(rng));
+    }
+    return result;
+}
+
+// Маршрут, полученный островом при обмене, откладывает феромон на свои рёбра
+// и становится лучшим с той же стоимостью, что считают муравьи
+void testIslandImportedRoute() {
+    const int n = 30;
+    const double q = 100.0;
+
+    IslandModel model;
+    for (int island = 0; island < 2; ++island) {
+        std::unique_ptr<AntColony> colony(new AntColony(n, 10, 1.0, 2.0, 0.5, q, 10));
+        colony->setSeed(island + 1);
+        colony->setThreadCount(1);
+        model.addIsland(std::move(colony));
+    }
+    model.setGraph(randomVertices(n, 7));
+    AntColony& island = model.getIsland(0);
+
+    // Маршрут начинается не с вершины 0, чтобы позиция в маршруте не совпадала с вершиной
+    std::vector<int> route(n);
+    for (int i = 0; i < n; ++i) {
+        route[i] = i;
+    }
+    std::shuffle(route.begin(), route.end(), std::mt19937(3));
+    if (route[0] == 0) {
+        std::swap(route[0], route[1]);
+    }
+
+    double cost = 0.0;
+    std::vector<bool> onRoute(n * n, false);
+    for (int i = 0; i < n; ++i) {
+        int from = route[i];
+        int to = route[(i + 1) % n];
+        cost += island.getDistance(from, to);
+        if (i + 1 < n) {
+            cost += island.getVertices()[to].visitCost;
+        }
+        onRoute[from * n + to] = true;
+        onRoute[to * n + from] = true;
+    }
+
+    std::vector<double> before(n * n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            before[i * n + j] = island.getPheromone(i, j);
+        }
+    }
+
+    CHECK(island.importRoute(route));
+    CHECK(nearlyEqual(island.getBestCost(), cost));
+    CHECK(island.getBestRoute() == route);
+
+    for (int i = 0; i < n; ++i) {
+        int from = route[i];
+        int to = route[(i + 1) % n];
+        CHECK(nearlyEqual(island.getPheromone(from, to), before[from * n + to] + q / cost));
+    }
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            if (i != j && !onRoute[i * n + j]) {
+                CHECK(island.getPheromone(i, j) == before[i * n + j]);
+            }
+        }
+    }
+
+    // Тот же маршрут повторно не улучшает лучший
+    CHECK(!island.importRoute(route));
+    CHECK(nearlyEqual(island.getBestCost(), cost));
+}
+
+// run() возвращается, как только срабатывает условие досрочного завершения
+void testRunStopsOnTermination() {
+    AntColony colony(20, 5, 1.0, 2.0, 0.5, 100.0, 1000);
+    colony.setSeed(1);
+    colony.setThreadCount(1);
+    colony.setGraph(randomVertices(20, 5));
+
+    TerminationCriteria criteria;
+    criteria.stallIterations = 3;
+    colony.setTermination(criteria);
+    colony.run();
+
+    CHECK(colony.getTerminationReason() == TerminationReason::NoImprovement);
+    CHECK(colony.getCurrentIteration() < 1000);
+}
+
+// Увеличенный лимит итераций возобновляет колонию, остановленную по лимиту
+void testRaisedIterationLimit() {
+    AntColony colony(20, 5, 1.0, 2.0, 0.5, 100.0, 20);
+    colony.setSeed(1);
+    colony.setThreadCount(1);
+    colony.setGraph(randomVertices(20, 9));
+    colony.run();
+    CHECK(colony.getTerminationReason() == TerminationReason::IterationLimit);
+    CHECK(colony.getCurrentIteration() == 20);
+
+    colony.moveVertex(3, Point(500.0, 500.0));
+    colony.setMaxIterations(30);
+    CHECK(!colony.isFinished());
+    colony.run();
+    CHECK(colony.getCurrentIteration() == 30);
+    CHECK(colony.getTerminationReason() == TerminationReason::IterationLimit);
+}
+
+// Ожидание снимка, для которого выполнено условие (не дольше нескольких секунд)
+template <typename Predicate>
+bool waitForSnapshot(SolverRunner& runner, Predicate predicate) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < deadline) {
+        runner.poll();
+        if (predicate(runner.snapshot())) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+// Запуск сразу после остановки или сброса не теряется, даже если поток
+// решателя получает обе команды вместе
+void testRunnerStartAfterStopOrReset() {
+    AntColony colony(200, 20, 1.0, 2.0, 0.5, 100.0, std::numeric_limits<int>::max());
+    colony.setSeed(1);
+    colony.setThreadCount(1);
+    colony.setGraph(randomVertices(200, 11));
+
+    SolverRunner runner(&colony);
+    runner.start();
+    CHECK(waitForSnapshot(runner, [](const ColonySnapshot& s) { return s.running && s.iteration > 0; }));
+
+    for (int round = 0; round < 10; ++round) {
+        runner.stop();
+        runner.start();
+        int iteration = runner.snapshot().iteration;
+        CHECK(waitForSnapshot(runner, [iteration](const ColonySnapshot& s) { return s.running && s.iteration > iteration; }));
+
+        runner.reset();
+        runner.start();
+        CHECK(waitForSnapshot(runner, [](const ColonySnapshot& s) { return s.running && s.iteration > 0; }));
+    }
+
+    // Остановка после запуска по-прежнему останавливает
+    runner.start();
+    runner.stop();
+    CHECK(waitForSnapshot(runner, [](const ColonySnapshot& s) { return !s.running; }));
+}
+
+// Запись трассы, данных которой не хватает для декодирования, отвергается при открытии
+void testTraceShortRecord() {
+    const int n = 20;
+    const std::string path = "aco-tests.acotrace";
+
+    AntColony colony(n, 5, 1.0, 2.0, 0.5, 100.0, 10);
+    colony.setSeed(1);
+    colony.setThreadCount(1);
+    colony.setGraph(randomVertices(n, 13));
+
+    std::string error;
+    TraceRecorder recorder;
+    CHECK(recorder.open(path, colony, 5, true, error));
+    for (int i = 0; i < 10; ++i) {
+        colony.runIteration();
+        recorder.record(colony);
+    }
+    recorder.close();
+
+    TraceReader reader;
+    ColonySnapshot snapshot;
+    CHECK(reader.open(path, error));
+    CHECK(reader.seek(9, snapshot));
+    CHECK(static_cast<int>(snapshot.bestRoute.size()) == n);
+
+    // Размер первого ключевого кадра уменьшается до заголовка и маршрута без феромонов
+    std::FILE* file = std::fopen(path.c_str(), "r+b");
+    CHECK(file != nullptr);
+    if (file) {
+        long offset = static_cast<long>(sizeof(TraceHeader) + n * 3 * sizeof(double));
+        TraceRecordHeader record;
+        std::fseek(file, offset, SEEK_SET);
+        CHECK(std::fread(&record, sizeof(record), 1, file) == 1);
+        CHECK(record.type == TraceKeyframe);
+        record.size = 2 * sizeof(std::int32_t) + sizeof(double) + n * sizeof(std::int32_t);
+        std::fseek(file, offset, SEEK_SET);
+        std::fwrite(&record, sizeof(record), 1, file);
+        std::fclose(file);
+    }
+
+    TraceReader corrupt;
+    error.clear();
+    CHECK(!corrupt.open(path, error));
+    CHECK(error.find("corrupt") != std::string::npos);
+    std::remove(path.c_str());
+}
+
+// Запись поля заголовка контрольной точки в образ
+template <typename T>
+void patchCheckpoint(std::vector<char>& image, std::size_t offset, T value) {
+    std::memcpy(image.data() + offset, &value, sizeof(value));
+}
+
+CheckpointHeader checkpointHeader(const std::vector<char>& image) {
+    CheckpointHeader header;
+    std::memcpy(&header, image.data(), sizeof(header));
+    return header;
+}
+
+// Восстановление повреждённого образа отвергается, а колония остаётся прежней
+void checkRejected(const std::vector<char>& image, const char* expectedError) {
+    AntColony colony(30, 5, 1.0, 2.0, 0.5, 100.0, 50);
+    colony.setSeed(4);
+    colony.setThreadCount(1);
+    colony.setGraph(randomVertices(30, 17));
+    colony.runIteration();
+    std::vector<int> route = colony.getBestRoute();
+    double cost = colony.getBestCost();
+
+    std::string error;
+    CHECK(!colony.restoreState(image.data(), image.size(), error));
+    CHECK(error == expectedError);
+    CHECK(colony.getNumVertices() == 30);
+    CHECK(colony.getCurrentIteration() == 1);
+    CHECK(colony.getBestRoute() == route);
+    CHECK(colony.getBestCost() == cost);
+    colony.runIteration();
+    CHECK(colony.getCurrentIteration() == 2);
+}
+
+// Восстановленная колония продолжает так же, как исходная; повреждённые образы отвергаются
+void testCheckpointRestore() {
+    AntColony original(40, 8, 1.0, 2.0, 0.3, 100.0, 100);
+    original.setSeed(2);
+    original.setThreadCount(1);
+    original.setVariant(AcoVariant::MaxMinAntSystem);
+    original.setGraph(randomVertices(40, 19));
+    for (int i = 0; i < 10; ++i) {
+        original.runIteration();
+    }
+
+    std::vector<char> image;
+    original.saveState(image);
+
+    AntColony restored(2, 1, 1.0, 1.0, 0.5, 1.0, 1);
+    restored.setThreadCount(1);
+    std::string error;
+    CHECK(restored.restoreState(image.data(), image.size(), error));
+    CHECK(restored.getNumVertices() == 40);
+    CHECK(restored.getCurrentIteration() == 10);
+    CHECK(restored.getVariant() == AcoVariant::MaxMinAntSystem);
+    CHECK(restored.getBestRoute() == original.getBestRoute());
+    for (int i = 0; i < 10; ++i) {
+        original.runIteration();
+        restored.runIteration();
+    }
+    CHECK(restored.getBestCost() == original.getBestCost());
+    CHECK(restored.getBestRoute() == original.getBestRoute());
+
+    const CheckpointHeader header = checkpointHeader(image);
+
+    std::vector<char> badRoute = image;
+    patchCheckpoint(badRoute, header.bestRoute.offset + 3 * sizeof(std::int32_t), std::int32_t(1000000));
+    checkRejected(badRoute, "corrupt checkpoint route");
+
+    std::vector<char> repeatedVertex = image;
+    std::int32_t first;
+    std::memcpy(&first, image.data() + header.bestRoute.offset, sizeof(first));
+    patchCheckpoint(repeatedVertex, header.bestRoute.offset + sizeof(std::int32_t), first);
+    checkRejected(repeatedVertex, "corrupt checkpoint route");
+
+    std::vector<char> badVariant = image;
+    patchCheckpoint(badVariant, offsetof(CheckpointHeader, variant), std::int32_t(99));
+    checkRejected(badVariant, "corrupt checkpoint");
+
+    std::vector<char> badMetric = image;
+    patchCheckpoint(badMetric, offsetof(CheckpointHeader, metric), std::int32_t(-1));
+    checkRejected(badMetric, "corrupt checkpoint");
+
+    // Компактный режим при феромонах полной матрицы
+    std::vector<char> storageMismatch = image;
+    patchCheckpoint(storageMismatch, offsetof(CheckpointHeader, storageMode),
+                    static_cast<std::int32_t>(StorageMode::Compact));
+    checkRejected(storageMismatch, "checkpoint storage does not match the instance");
+
+    std::vector<char> badRng = image;
+    patchCheckpoint(badRng, offsetof(CheckpointHeader, rngWords), header.rngWords - 1);
+    checkRejected(badRng, "corrupt checkpoint");
+}
+
+bool withinTolerance(double value, double expected, double tolerance) {
+    return std::fabs(value - expected) <= tolerance * std::max(std::fabs(expected), 1e-300);
+}
+
+// Векторное ядро совпадает со скалярным при всех целых показателях, с множителем
+// и маской и без них, для длин строк с неполным последним вектором
+template <typename T>
+void compareKernel(SimdIsa isa, int n, double tolerance, std::mt19937& rng) {
+    std::uniform_real_distribution<double> baseValue(0.01, 10.0);
+    std::uniform_real_distribution<double> factorValue(0.001, 1.0);
+    std::vector<T> base(n), factor(n), expected(n), actual(n);
+    std::vector<char> visited(n);
+    for (int j = 0; j < n; ++j) {
+        base[j] = static_cast<T>(baseValue(rng));
+        factor[j] = static_cast<T>(factorValue(rng));
+        visited[j] = static_cast<char>(rng() % 3 == 0);
+    }
+
+    for (int alpha = 0; alpha <= 4; ++alpha) {
+        for (int beta = 0; beta <= 4; ++beta) {
+            for (int variant = 0; variant < 4; ++variant) {
+                const T* factorRow = variant & 1 ? factor.data() : nullptr;
+                const char* mask = variant & 2 ? visited.data() : nullptr;
+
+                double expectedSum = maskedWeights(SimdIsa::Scalar, base.data(), factorRow, mask, n, alpha, beta,
+                                                   expected.data());
+                double sum = maskedWeights(isa, base.data(), factorRow, mask, n, alpha, beta, actual.data());
+
+                bool rowMatches = withinTolerance(sum, expectedSum, tolerance);
+                for (int j = 0; j < n; ++j) {
+                    rowMatches = rowMatches && withinTolerance(actual[j], expected[j], tolerance) &&
+                                 (!mask || !mask[j] || actual[j] == T(0));
+                }
+                if (!rowMatches) {
+                    std::fprintf(stderr, "kernel %s, %zu-byte values, n = %d, alpha = %d, beta = %d, "
+                                 "factor %s, mask %s\n", simdIsaName(isa), sizeof(T), n, alpha, beta,
+                                 factorRow ? "yes" : "no", mask ? "yes" : "no");
+                }
+                CHECK(rowMatches);
+            }
+        }
+    }
+}
+
+void testChoiceKernels() {
+    std::mt19937 rng(21);
+    std::vector<int> lengths;
+    for (int n = 1; n <= 40; ++n) {
+        lengths.push_back(n);
+    }
+    for (int n : { 63, 64, 65, 127, 129, 1001 }) {
+        lengths.push_back(n);
+    }
+
+    for (SimdIsa isa : { SimdIsa::Sse41, SimdIsa::Avx2, SimdIsa::Avx512 }) {
+        if (!isSimdIsaSupported(isa)) {
+            continue;
+        }
+        for (int n : lengths) {
+            compareKernel<double>(isa, n, 1e-12, rng);
+            compareKernel<float>(isa, n, 1e-5, rng);
+        }
+    }
+}
+
+// Расстояние GEO считается с π = 3.141592, как в TSPLIB: для этой пары точное
+// значение π даёт 5749 после округления
+void testGeoDistance() {
+    CHECK(metricDistance(DistanceMetric::Geo, Point(4.36, 56.36), Point(-46.52, 61.17)) == 5748.0);
+}
+
+// Загрузка TSPLIB-файла с заданным содержимым; error - сообщение загрузчика
+bool loadTsplibText(const char* text, Instance& instance, std::string& error) {
+    const std::string path = "aco-tests.tsp";
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        error = "cannot create " + path;
+        return false;
+    }
+    std::fputs(text, file);
+    std::fclose(file);
+
+    bool loaded = loadTsplib(path, instance, error);
+    std::remove(path.c_str());
+    return loaded;
+}
+
+// Номера вершин и DIMENSION вне диапазона int или дробные, а также DIMENSION
+// больше, чем помещается в файле, отвергаются сообщением загрузчика
+void testTsplibRanges() {
+    Instance instance;
+    std::string error;
+
+    CHECK(loadTsplibText("DIMENSION: 3\nEDGE_WEIGHT_TYPE: EUC_2D\nNODE_COORD_SECTION\n"
+                         "1 0 0\n2 3 4\n3 6 8\nEOF\n", instance, error));
+    CHECK(instance.vertices.size() == 3);
+
+    CHECK(!loadTsplibText("DIMENSION: 1e12\nEDGE_WEIGHT_TYPE: EUC_2D\nNODE_COORD_SECTION\n1 0 0\n",
+                          instance, error));
+    CHECK(error == "invalid DIMENSION");
+    CHECK(!loadTsplibText("DIMENSION: 2.5\nEDGE_WEIGHT_TYPE: EUC_2D\nNODE_COORD_SECTION\n1 0 0\n",
+                          instance, error));
+    CHECK(error == "invalid DIMENSION");
+
+    CHECK(!loadTsplibText("DIMENSION: 2000000000\nEDGE_WEIGHT_TYPE: EUC_2D\nNODE_COORD_SECTION\n"
+                          "1 0 0\n2 3 4\n", instance, error));
+    CHECK(error == "truncated coordinate section");
+    CHECK(!loadTsplibText("DIMENSION: 100000\nEDGE_WEIGHT_TYPE: EXPLICIT\nEDGE_WEIGHT_FORMAT: FULL_MATRIX\n"
+                          "EDGE_WEIGHT_SECTION\n0 1\n1 0\n", instance, error));
+    CHECK(error == "truncated EDGE_WEIGHT_SECTION");
+
+    CHECK(!loadTsplibText("DIMENSION: 3\nEDGE_WEIGHT_TYPE: EUC_2D\nNODE_COORD_SECTION\n"
+                          "1 0 0\n1e12 3 4\n3 6 8\n", instance, error));
+    CHECK(error == "invalid or duplicate node number 1000000000000");
+    CHECK(!loadTsplibText("DIMENSION: 3\nEDGE_WEIGHT_TYPE: EUC_2D\nNODE_COORD_SECTION\n"
+                          "1 0 0\n1.5 3 4\n3 6 8\n", instance, error));
+    CHECK(error == "invalid or duplicate node number 1.5");
+}
+
+} // namespace
+
+int main() {
+    testIslandImportedRoute();
+    testRunStopsOnTermination();
+    testRaisedIterationLimit();
+    testRunnerStartAfterStopOrReset();
+    testTraceShortRecord();
+    testCheckpointRestore();
+    testChoiceKernels();
+    testGeoDistance();
+    testTsplibRanges();
+
+    if (failures > 0) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("all checks passed\n");
+    return 0;
+}
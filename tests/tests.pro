@@ -0,0 +1,10 @@
+TEMPLATE = app
+TARGET = aco-tests
+
+CONFIG += console c++17
+CONFIG -= qt app_bundle
+
+include(../core/core.pri)
+
+SOURCES += \
+    main.cpp
@@ -0,0 +1,312 @@
+#include "antcolony.h"
+#include "configfile.h"
+#include "tsplib.h"
+#include "tuner.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Параметры подбора
+struct Options {
+    std::vector<std::string> instancePaths;  // Задачи TSPLIB
+    std::vector<int> randomVertices;         // Размеры случайных задач
+    TuningSpace space;
+    TuningSettings settings;
+    int candidates = 15;
+    std::string variant = "as";
+    std::string localSearch = "none";
+    std::string outputPrefix = "tuned";
+    int top = 10;
+};
+
+// Классы задач по размеру: для каждого подбирается свой набор параметров
+struct SizeClass {
+    const char* name;
+    int maxVertices;
+};
+
+const SizeClass SizeClasses[] = {
+    { "small", 100 },
+    { "medium", 500 },
+    { "large", 2000 },
+    { "huge", 0 }       // 0 - без ограничения
+};
+
+void printUsage(const char* program) {
+    std::fprintf(stderr,
+        "Usage: %s [options] [instance.tsp ...]\n"
+        "Searches for colony parameters by successive halving over the given\n"
+        "instances and writes the best set of each size class to a config file\n"
+        "that aco-solve --config and the GUI can load.\n"
+        "\n"
+        "Instances:\n"
+        "  --random N        add a random instance with N vertices (repeatable)\n"
+        "\n"
+        "Search space (LOW:HIGH:LEVELS or a single value):\n"
+        "  --ants R          number of ants (default 20)\n"
+        "  --alpha R         pheromone weight (default 0.5:2:4)\n"
+        "  --beta R          heuristic weight (default 1:5:5)\n"
+        "  --rho R           evaporation rate (default 0.1:0.7:4)\n"
+        "  --q R             deposit constant (default 100)\n"
+        "\n"
+        "Fixed solver options:\n"
+        "  --variant V       as, elitist, rank, mmas, acs (default as)\n"
+        "  --candidates K    nearest-neighbour list size (default 15)\n"
+        "  --local-search M  none, best, all (default none)\n"
+        "\n"
+        "Tuning:\n"
+        "  --iterations N    iterations per run in the first round (default 25)\n"
+        "  --seeds N         runs per instance and set (default 3)\n"
+        "  --eta N           keep 1/N of the sets per round (default 2)\n"
+        "  --max-configs N   sample N sets if the grid is larger (default 64)\n"
+        "  --threads N       parallel runs (default: hardware threads)\n"
+        "  --seed N          seed of runs and sampling (default 1)\n"
+        "  --output PREFIX   write PREFIX-<class>.conf (default tuned)\n"
+        "  --top N           sets printed per class (default 10)\n"
+        "  --help            show this help\n",
+        program);
+}
+
+// Диапазон "low:high:levels" или одно значение
+bool parseRange(const char* text, TuningRange& range) {
+    double low = 0.0, high = 0.0;
+    int levels = 0;
+    if (std::sscanf(text, "%lf:%lf:%d", &low, &high, &levels) == 3 && levels >= 1) {
+        range = TuningRange(low, high, levels);
+        return true;
+    }
+    char* end = nullptr;
+    low = std::strtod(text, &end);
+    if (end == text || *end != '\0') {
+        return false;
+    }
+    range = TuningRange(low);
+    return true;
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    options.space.alpha = TuningRange(0.5, 2.0, 4);
+    options.space.beta = TuningRange(1.0, 5.0, 5);
+    options.space.rho = TuningRange(0.1, 0.7, 4);
+    options.settings.threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0) {
+            printUsage(argv[0]);
+            std::exit(0);
+        } else if (arg[0] == '-' && arg[1] == '-') {
+            if (!hasValue) {
+                std::fprintf(stderr, "Missing value for %s\n", arg);
+                return false;
+            }
+            const char* value = argv[++i];
+
+            TuningRange* range = nullptr;
+            if (std::strcmp(arg, "--ants") == 0) range = &options.space.ants;
+            else if (std::strcmp(arg, "--alpha") == 0) range = &options.space.alpha;
+            else if (std::strcmp(arg, "--beta") == 0) range = &options.space.beta;
+            else if (std::strcmp(arg, "--rho") == 0) range = &options.space.rho;
+            else if (std::strcmp(arg, "--q") == 0) range = &options.space.Q;
+
+            if (range) {
+                if (!parseRange(value, *range)) {
+                    std::fprintf(stderr, "Invalid range %s for %s\n", value, arg);
+                    return false;
+                }
+            }
+            else if (std::strcmp(arg, "--random") == 0) options.randomVertices.push_back(std::atoi(value));
+            else if (std::strcmp(arg, "--variant") == 0) options.variant = value;
+            else if (std::strcmp(arg, "--candidates") == 0) options.candidates = std::atoi(value);
+            else if (std::strcmp(arg, "--local-search") == 0) options.localSearch = value;
+            else if (std::strcmp(arg, "--iterations") == 0) options.settings.iterations = std::atoi(value);
+            else if (std::strcmp(arg, "--seeds") == 0) options.settings.seeds = std::atoi(value);
+            else if (std::strcmp(arg, "--eta") == 0) options.settings.eta = std::atoi(value);
+            else if (std::strcmp(arg, "--max-configs") == 0) options.settings.maxCandidates = std::atoi(value);
+            else if (std::strcmp(arg, "--threads") == 0) options.settings.threads = std::atoi(value);
+            else if (std::strcmp(arg, "--seed") == 0) options.settings.seed = static_cast<unsigned int>(std::atol(value));
+            else if (std::strcmp(arg, "--output") == 0) options.outputPrefix = value;
+            else if (std::strcmp(arg, "--top") == 0) options.top = std::atoi(value);
+            else {
+                std::fprintf(stderr, "Unknown option %s\n", arg);
+                return false;
+            }
+        } else {
+            options.instancePaths.push_back(arg);
+        }
+    }
+
+    if (options.instancePaths.empty() && options.randomVertices.empty()) {
+        std::fprintf(stderr, "no instances: give TSPLIB files or --random N\n");
+        return false;
+    }
+    for (int vertices : options.randomVertices) {
+        if (vertices < 5) {
+            std::fprintf(stderr, "random instances need at least 5 vertices\n");
+            return false;
+        }
+    }
+    if (options.settings.iterations <= 0 || options.settings.seeds <= 0 || options.settings.eta < 2 ||
+        options.settings.threads <= 0) {
+        std::fprintf(stderr, "iterations, seeds and threads must be positive, eta at least 2\n");
+        return false;
+    }
+    if (options.space.ants.low < 1.0 || options.space.rho.low <= 0.0 || options.space.rho.high >= 1.0) {
+        std::fprintf(stderr, "ants must be at least 1 and rho within (0, 1)\n");
+        return false;
+    }
+    return true;
+}
+
+// Фиксированные настройки колонии (одинаковые для всех наборов)
+bool makeConfigure(const Options& options, std::function<void(AntColony&)>& configure) {
+    AcoVariant variant;
+    if (options.variant == "as") variant = AcoVariant::AntSystem;
+    else if (options.variant == "elitist") variant = AcoVariant::ElitistAntSystem;
+    else if (options.variant == "rank") variant = AcoVariant::RankBasedAntSystem;
+    else if (options.variant == "mmas") variant = AcoVariant::MaxMinAntSystem;
+    else if (options.variant == "acs") variant = AcoVariant::AntColonySystem;
+    else {
+        std::fprintf(stderr, "Unknown variant %s\n", options.variant.c_str());
+        return false;
+    }
+
+    LocalSearchMode localSearch;
+    if (options.localSearch == "none") localSearch = LocalSearchMode::None;
+    else if (options.localSearch == "best") localSearch = LocalSearchMode::IterationBest;
+    else if (options.localSearch == "all") localSearch = LocalSearchMode::AllAnts;
+    else {
+        std::fprintf(stderr, "Unknown local search mode %s\n", options.localSearch.c_str());
+        return false;
+    }
+
+    int candidates = options.candidates;
+    configure = [variant, localSearch, candidates](AntColony& colony) {
+        colony.setVariant(variant, VariantParameters());
+        colony.setLocalSearch(localSearch);
+        colony.setCandidateListSize(candidates);
+    };
+    return true;
+}
+
+// Случайная задача с воспроизводимыми координатами
+Instance randomInstance(int vertices, unsigned int seed) {
+    AntColony generator(vertices, 1, 1.0, 1.0, 0.5, 100.0, 1);
+    generator.setSeed(seed);
+    generator.generateRandomGraph(1000, 1000);
+
+    Instance instance;
+    instance.name = "random" + std::to_string(vertices);
+    instance.vertices = generator.getVertices();
+    return instance;
+}
+
+int sizeClassOf(const Instance& instance) {
+    int n = static_cast<int>(instance.vertices.size());
+    int last = static_cast<int>(sizeof(SizeClasses) / sizeof(SizeClasses[0])) - 1;
+    for (int c = 0; c < last; ++c) {
+        if (n <= SizeClasses[c].maxVertices) {
+            return c;
+        }
+    }
+    return last;
+}
+
+bool writeResult(const std::string& path, const Options& options, const TuningResult& best,
+                 const std::vector<Instance>& instances, std::string& error) {
+    std::vector<ConfigEntry> entries = {
+        { "ants", std::to_string(best.candidate.ants) },
+        { "alpha", std::to_string(best.candidate.alpha) },
+        { "beta", std::to_string(best.candidate.beta) },
+        { "rho", std::to_string(best.candidate.rho) },
+        { "q", std::to_string(best.candidate.Q) },
+        { "iterations", std::to_string(best.iterations) },
+        { "variant", options.variant },
+        { "candidates", std::to_string(options.candidates) },
+        { "local-search", options.localSearch }
+    };
+
+    std::string comment = "aco-tune: " + std::to_string(best.rounds) + " rounds, " +
+                          std::to_string(best.evaluations) + " runs, mean gap " +
+                          std::to_string(best.meanGap * 100.0) + "%\ninstances:";
+    for (const Instance& instance : instances) {
+        comment += " " + instance.name;
+    }
+    return writeConfigFile(path, entries, comment, error);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options) || !makeConfigure(options, options.settings.configure)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    // Задачи по классам размера
+    const int classCount = static_cast<int>(sizeof(SizeClasses) / sizeof(SizeClasses[0]));
+    std::vector<std::vector<Instance>> classes(classCount);
+    for (const std::string& path : options.instancePaths) {
+        Instance instance;
+        std::string error;
+        if (!loadTsplib(path, instance, error)) {
+            std::fprintf(stderr, "%s: %s\n", path.c_str(), error.c_str());
+            return 1;
+        }
+        classes[sizeClassOf(instance)].push_back(std::move(instance));
+    }
+    for (size_t i = 0; i < options.randomVertices.size(); ++i) {
+        Instance instance = randomInstance(options.randomVertices[i], options.settings.seed + static_cast<unsigned int>(i));
+        classes[sizeClassOf(instance)].push_back(std::move(instance));
+    }
+
+    for (int c = 0; c < classCount; ++c) {
+        if (classes[c].empty()) {
+            continue;
+        }
+
+        ParameterTuner tuner;
+        tuner.setSpace(options.space);
+        tuner.setSettings(options.settings);
+        for (const Instance& instance : classes[c]) {
+            tuner.addInstance(instance);
+        }
+        tuner.setProgressCallback([&](int round, int candidates, int iterations) {
+            std::printf("%s: round %d, %d sets x %d runs, %d iterations\n", SizeClasses[c].name, round + 1,
+                        candidates, tuner.getInstanceCount() * options.settings.seeds, iterations);
+            std::fflush(stdout);
+        });
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<TuningResult> results = tuner.run();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::printf("\n%s (%d instances, %.1f s)\n", SizeClasses[c].name, tuner.getInstanceCount(), seconds);
+        std::printf("%4s %6s %7s %7s %7s %9s %7s %9s\n", "rank", "ants", "alpha", "beta", "rho", "q", "rounds", "gap %");
+        for (int i = 0; i < std::min(options.top, static_cast<int>(results.size())); ++i) {
+            const TuningResult& result = results[i];
+            std::printf("%4d %6d %7.3f %7.3f %7.3f %9.2f %7d %9.3f\n", i + 1, result.candidate.ants,
+                        result.candidate.alpha, result.candidate.beta, result.candidate.rho, result.candidate.Q,
+                        result.rounds, result.meanGap * 100.0);
+        }
+
+        std::string path = options.outputPrefix + "-" + SizeClasses[c].name + ".conf";
+        std::string error;
+        if (!writeResult(path, options, results.front(), classes[c], error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+        std::printf("written %s\n\n", path.c_str());
+    }
+    return 0;
+}
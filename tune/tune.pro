@@ -0,0 +1,15 @@
+TEMPLATE = app
+TARGET = aco-tune
+
+CONFIG += console c++17
+CONFIG -= qt app_bundle
+
+include(../core/core.pri)
+
+SOURCES += \
+    main.cpp
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target